@@ -22,6 +22,7 @@
 #include "SAMRAI/hier/Variable.h"
 #include "SAMRAI/hier/VariableContext.h"
 #include "SAMRAI/mesh/GriddingAlgorithm.h"
+#include "SAMRAI/mesh/MeasuredWorkload.h"
 #include "SAMRAI/mesh/StandardTagAndInitStrategy.h"
 #include "SAMRAI/tbox/Database.h"
 #include "SAMRAI/tbox/Serializable.h"
@@ -102,6 +103,25 @@ namespace algs {
  *       indicates whether ghost data must be filled before timestep is
  *       computed on each patch (possible communication optimization)
  *
+ *    - \b    overlap_interior_fluxes
+ *       indicates whether fluxes that need no ghost data are computed
+ *       while the ghost cells are being filled, using
+ *       HyperbolicPatchStrategy::computeInteriorFluxesOnPatch().  In
+ *       this mode the interior fluxes are computed before
+ *       HyperbolicPatchStrategy::preprocessAdvanceLevelState() is called,
+ *       and no other communication may be started from those routines.
+ *
+ *    - \b    use_measured_workload
+ *       indicates whether the time spent in the numerical routines on
+ *       each patch is measured and given to the load balancers as
+ *       workload data (see mesh::MeasuredWorkload).  This replaces any
+ *       workload data index set by
+ *       HyperbolicPatchStrategy::setupLoadBalancer().
+ *
+ *    - \b    measured_workload_smoothing
+ *       weight of the newest measurement in the moving average of the
+ *       measured workload, in (0,1]
+ *
  * Note that when continuing from restart, the input parameters in the input
  * database override all values read in from the restart database.
  *
@@ -147,6 +167,30 @@ namespace algs {
  *     <td>opt</td>
  *     <td>Parameter read from restart db may be overridden by input db</td>
  *   </tr>
+ *   <tr>
+ *     <td>overlap_interior_fluxes</td>
+ *     <td>bool</td>
+ *     <td>FALSE</td>
+ *     <td>TRUE, FALSE</td>
+ *     <td>opt</td>
+ *     <td>Parameter read from restart db may be overridden by input db</td>
+ *   </tr>
+ *   <tr>
+ *     <td>use_measured_workload</td>
+ *     <td>bool</td>
+ *     <td>FALSE</td>
+ *     <td>TRUE, FALSE</td>
+ *     <td>opt</td>
+ *     <td>Parameter read from restart db may be overridden by input db</td>
+ *   </tr>
+ *   <tr>
+ *     <td>measured_workload_smoothing</td>
+ *     <td>double</td>
+ *     <td>0.5</td>
+ *     <td>0.0 < measured_workload_smoothing <= 1.0</td>
+ *     <td>opt</td>
+ *     <td>Parameter read from restart db may be overridden by input db</td>
+ *   </tr>
  * </table>
  *
  * A sample input file entry might look like:
@@ -959,10 +1003,27 @@ private:
     *                       will replace coarse fluxes with integrated
     *                       finer level fluxes and repeat the conservative
     *                       update.  The default is true.
+    *
+    * d_overlap_interior_fluxes indicates whether interior fluxes are
+    *                       computed while ghost cells are filled.  The
+    *                       default is false.
+    *
+    * d_use_measured_workload indicates whether patch compute times are
+    *                       recorded as workload data.  The default is
+    *                       false.
     */
    bool d_lag_dt_computation;
    bool d_use_ghosts_for_dt;
    bool d_use_flux_correction;
+   bool d_overlap_interior_fluxes;
+   bool d_use_measured_workload;
+   double d_measured_workload_smoothing;
+
+   /*
+    * Workload data built from measured patch compute times, created in
+    * initializeLevelIntegrator() when d_use_measured_workload is true.
+    */
+   std::shared_ptr<mesh::MeasuredWorkload> d_measured_workload;
 
    /*
     * Boolean flags for indicated whether face or side data types are
@@ -153,6 +153,43 @@ public:
       const double time,
       const double dt) = 0;
 
+   /**
+    * This is an optional routine used by the level integrator when the
+    * input parameter overlap_interior_fluxes is TRUE.  It computes the
+    * same flux integrals as computeFluxesOnPatch(), but only on the cell
+    * faces whose stencils do not reach into the ghost cells.  It is
+    * called while the ghost cell data is still being communicated, so
+    * only the interior of the scratch data may be used.  The return value
+    * indicates whether the interior fluxes were computed.  If it is true,
+    * computeBoundaryFluxesOnPatch() is called once the ghost cells are
+    * filled to compute the remaining faces; otherwise
+    * computeFluxesOnPatch() is called as usual.
+    *
+    * Note that this function is not pure virtual. It is given a
+    * dummy implementation here, which computes nothing and returns false,
+    * so that users may ignore it when inheriting from this class.
+    */
+   virtual bool
+   computeInteriorFluxesOnPatch(
+      hier::Patch& patch,
+      const double time,
+      const double dt);
+
+   /**
+    * This is an optional routine that completes the flux integrals on a
+    * patch for which computeInteriorFluxesOnPatch() returned true.  It is
+    * called after the ghost cells are filled and must compute the fluxes
+    * on the faces that computeInteriorFluxesOnPatch() skipped.
+    *
+    * Note that this function is not pure virtual. It is given a
+    * default implementation here that calls computeFluxesOnPatch().
+    */
+   virtual void
+   computeBoundaryFluxesOnPatch(
+      hier::Patch& patch,
+      const double time,
+      const double dt);
+
    /**
     * Update patch data with a conservative difference (approximating
     * the divergence theorem) using the flux integrals computed in
@@ -18,6 +18,7 @@
 #include "SAMRAI/hier/ComponentSelector.h"
 #include "SAMRAI/tbox/Database.h"
 #include "SAMRAI/mesh/GriddingAlgorithm.h"
+#include "SAMRAI/mesh/MeasuredWorkload.h"
 #include "SAMRAI/algs/MethodOfLinesPatchStrategy.h"
 #include "SAMRAI/hier/PatchHierarchy.h"
 #include "SAMRAI/hier/PatchLevel.h"
@@ -74,6 +75,16 @@ namespace algs {
  *       used in the multi-step Strong Stability Preserving (SSP) Runge-Kutta
  *       algorithm.
  *
+ *    - \b    use_measured_workload
+ *       indicates whether the time spent in
+ *       MethodOfLinesPatchStrategy::singleStep() on each patch is measured
+ *       and given to the load balancers as workload data (see
+ *       mesh::MeasuredWorkload).
+ *
+ *    - \b    measured_workload_smoothing
+ *       weight of the newest measurement in the moving average of the
+ *       measured workload, in (0,1]
+ *
  * Note that when continuing from restart, the input parameters in the input
  * database override all values read in from the restart database.
  *
@@ -111,6 +122,22 @@ namespace algs {
  *      <td>opt</td>
  *      <td>Parameter read from restart db may be overridden by input db</td>
  *   </tr>
+ *   <tr>
+ *      <td>use_measured_workload</td>
+ *      <td>bool</td>
+ *      <td>FALSE</td>
+ *      <td>TRUE, FALSE</td>
+ *      <td>opt</td>
+ *      <td>Parameter read from restart db may be overridden by input db</td>
+ *   </tr>
+ *   <tr>
+ *      <td>measured_workload_smoothing</td>
+ *      <td>double</td>
+ *      <td>0.5</td>
+ *      <td>0.0 < measured_workload_smoothing <= 1.0</td>
+ *      <td>opt</td>
+ *      <td>Parameter read from restart db may be overridden by input db</td>
+ *   </tr>
  * </table>
  *
  * The following represents a sample input entry:
@@ -408,6 +435,14 @@ private:
    std::vector<double> d_alpha_2;
    std::vector<double> d_beta;
 
+   /*
+    * Whether patch compute times are recorded as workload data, and the
+    * workload built from them (created in initializeIntegrator()).
+    */
+   bool d_use_measured_workload;
+   double d_measured_workload_smoothing;
+   std::shared_ptr<mesh::MeasuredWorkload> d_measured_workload;
+
    /*
     * A pointer to the method of lines patch model that will perform
     * the patch-based numerical operations.
@@ -96,7 +96,10 @@ namespace appu {
  *       common dump file.  This can reduce parallel I/O contention.
  *       The default value of this arg is 1.  If the value specified
  *       is greater than the number of processors, then all processors
- *       share a single dump file.
+ *       share a single dump file.  The processors sharing a file form a
+ *       file cluster: the first processor of the cluster writes the
+ *       file, and the others pack their plot data into messages that
+ *       it writes as they arrive.
  *
  *    - Register hierarchy variable data fields using
  *      registerPlotQuantity(). The variables registered may be scalar,
@@ -175,7 +178,9 @@ public:
     * number_procs_per_file is greater than the number of processors,
     * then all processors share a single vis dump file.  Reducing the
     * number of files written may reduce parallel I/O contention and
-    * thus improve I/O efficiency.  The optional argument is_multiblock
+    * thus improve I/O efficiency, at the cost of sending the plot data
+    * of each file cluster to the processor writing its file, which must
+    * hold the data of one cluster member at a time in memory.  The optional argument is_multiblock
     * defaults to false.  It must be set to true for problems on multiblock
     * domains, and left false in all other cases.
     *
@@ -754,9 +759,10 @@ private:
    static const int VISIT_MASTER;
 
    /*
-    * Static integer constant describing MPI message tag.
+    * Static integer constant describing MPI message tag for the plot data
+    * sent to file cluster leaders.
     */
-   static const int VISIT_FILE_CLUSTER_WRITE_BATON;
+   static const int VISIT_FILE_CLUSTER_DATA;
 
    /*
     * Static boolean that specifies if the summary file (d_summary_filename)
@@ -1076,13 +1082,21 @@ private:
       const void* s2);
 
    /*
-    * Barrier functions to enable orderly writing of cluster files by
-    * passing a baton from current writer to next proc in cluster.
+    * Receive the plot data of the other processors in the file cluster
+    * and write each into its processor group of the cluster file.  Called
+    * by the file cluster leader.
     */
    void
-   dumpWriteBarrierBegin();
+   receiveFileClusterData(
+      tbox::Database& cluster_file);
+
+   /*
+    * Send the plot data of this processor, written into a memory
+    * database, to the file cluster leader.
+    */
    void
-   dumpWriteBarrierEnd();
+   sendFileClusterData(
+      tbox::Database& processor_group);
 
    /*
     * Write summary data for VisIt to HDF file.
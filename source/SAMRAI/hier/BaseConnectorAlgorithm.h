@@ -22,6 +22,35 @@ namespace hier {
 
 class BaseConnectorAlgorithm
 {
+public:
+   /*!
+    * @brief Set the number of threads used to discover overlaps.
+    *
+    * Overlap discovery is threaded over the processes receiving
+    * messages and over the base Boxes whose neighbors are computed
+    * locally.  The results do not depend on the number of threads.
+    *
+    * @param[in] num_threads Number of threads, or 0 to use the OpenMP
+    * default, which respects OMP_NUM_THREADS.  Without OpenMP, only
+    * one thread is used.
+    *
+    * @pre num_threads >= 0
+    */
+   void
+   setNumberOfThreads(
+      int num_threads)
+   {
+      TBOX_ASSERT(num_threads >= 0);
+      d_num_threads = num_threads;
+   }
+
+   /*!
+    * @brief Return the number of threads used to discover overlaps,
+    * resolving the OpenMP default.
+    */
+   int
+   getNumberOfThreads() const;
+
 protected:
    /*!
     * @brief Constructor
@@ -73,6 +102,58 @@ protected:
       const std::shared_ptr<tbox::Timer>& receive_and_unpack_timer,
       bool print_steps) const;
 
+   /*!
+    * @brief Number of threads to use for a loop over num_items
+    * independent items, giving each thread at least
+    * min_items_per_thread items.
+    *
+    * Returns 1 when called from inside a parallel region.
+    */
+   int
+   getNumberOfThreadsForLoop(
+      int num_items,
+      int min_items_per_thread) const;
+
+   /*!
+    * @brief Neighbors found by one thread for its range of base Boxes.
+    *
+    * Base Box d_base_index[j] of the range has neighbors d_nabrs[k]
+    * for d_offsets[j] <= k < d_offsets[j+1].  Base Boxes without
+    * neighbors are not recorded.
+    */
+   struct NeighborBuffer {
+      NeighborBuffer():
+         d_offsets(1, 0) {
+      }
+      std::vector<int> d_base_index;
+      std::vector<int> d_offsets;
+      std::vector<Box> d_nabrs;
+   };
+
+   /*!
+    * @brief Compute the contiguous range [begin, end) of num_items
+    * items handled by thread thread_num of num_threads.
+    */
+   static void
+   getThreadRange(
+      int& begin,
+      int& end,
+      int num_items,
+      int thread_num,
+      int num_threads)
+   {
+      const int chunk = num_items / num_threads;
+      const int extra = num_items % num_threads;
+      begin = thread_num * chunk + (thread_num < extra ? thread_num : extra);
+      end = begin + chunk + (thread_num < extra ? 1 : 0);
+   }
+
+   /*!
+    * @brief Fewest base Boxes given to a thread when discovering
+    * local overlaps.
+    */
+   static const int MIN_BASE_BOXES_PER_THREAD;
+
 private:
    /*
     * Data length limit on first message of a communication.
@@ -86,6 +167,12 @@ private:
       Connector& west_to_east,
       Connector* east_to_west,
       bool print_steps) const;
+
+   /*!
+    * @brief Number of threads set by setNumberOfThreads(), 0 meaning
+    * the OpenMP default.
+    */
+   int d_num_threads;
 };
 
 }
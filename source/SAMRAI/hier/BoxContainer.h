@@ -19,6 +19,7 @@
 #include "SAMRAI/hier/PeriodicShiftCatalog.h"
 #include "SAMRAI/tbox/Utilities.h"
 
+#include <algorithm>
 #include <iostream>
 #include <list>
 #include <set>
@@ -76,6 +77,17 @@ class RealBoxConstIterator;
  * about the Boxes stored in the container, nor will it change the
  * ordered/unordered state of the container.
  *
+ * An ordered container may also be made "compact" by calling compact().
+ * A compact container keeps its Boxes in a single array sorted by BoxId
+ * instead of one heap node per Box, so it uses less memory and is faster
+ * to iterate and search.  It behaves as any other ordered container, but
+ * like std::vector, inserting or erasing Boxes invalidates iterators
+ * into it.  Inserting Boxes or erasing a single Box first returns the
+ * container to the default ordered storage; erasing a range keeps it
+ * compact.  Compact storage suits containers that are built in
+ * bulk and rarely changed afterwards, such as the globalized Boxes of a
+ * BoxLevel.
+ *
  * @see BoxId
  */
 class BoxContainer
@@ -135,7 +147,10 @@ public:
       {
          if (this != &rhs) {
             d_ordered = rhs.d_ordered;
-            if (d_ordered) {
+            d_compact = rhs.d_compact;
+            if (d_compact) {
+               d_vector_iter = rhs.d_vector_iter;
+            } else if (d_ordered) {
                d_set_iter = rhs.d_set_iter;
             } else {
                d_list_iter = rhs.d_list_iter;
@@ -157,7 +172,8 @@ public:
       const Box&
       operator * () const
       {
-         return d_ordered ? **d_set_iter : *d_list_iter;
+         return d_compact ? *d_vector_iter :
+                d_ordered ? **d_set_iter : *d_list_iter;
       }
 
       /*!
@@ -168,7 +184,8 @@ public:
       const Box *
       operator -> () const
       {
-         return d_ordered ? *d_set_iter : &(*d_list_iter);
+         return d_compact ? &(*d_vector_iter) :
+                d_ordered ? *d_set_iter : &(*d_list_iter);
       }
 
       /*!
@@ -182,7 +199,9 @@ public:
          int)
       {
          BoxContainerConstIterator return_iter(*this);
-         if (d_ordered) {
+         if (d_compact) {
+            ++d_vector_iter;
+         } else if (d_ordered) {
             ++d_set_iter;
          } else {
             ++d_list_iter;
@@ -199,7 +218,9 @@ public:
       const BoxContainerConstIterator&
       operator ++ ()
       {
-         if (d_ordered) {
+         if (d_compact) {
+            ++d_vector_iter;
+         } else if (d_ordered) {
             ++d_set_iter;
          } else {
             ++d_list_iter;
@@ -218,7 +239,9 @@ public:
          int)
       {
          BoxContainerConstIterator return_iter(*this);
-         if (d_ordered) {
+         if (d_compact) {
+            --d_vector_iter;
+         } else if (d_ordered) {
             --d_set_iter;
          } else {
             --d_list_iter;
@@ -235,7 +258,9 @@ public:
       const BoxContainerConstIterator&
       operator -- ()
       {
-         if (d_ordered) {
+         if (d_compact) {
+            --d_vector_iter;
+         } else if (d_ordered) {
             --d_set_iter;
          } else {
             --d_list_iter;
@@ -254,7 +279,8 @@ public:
       operator == (
          const BoxContainerConstIterator& other) const
       {
-         return d_ordered ? d_set_iter == other.d_set_iter :
+         return d_compact ? d_vector_iter == other.d_vector_iter :
+                d_ordered ? d_set_iter == other.d_set_iter :
                 d_list_iter == other.d_list_iter;
       }
 
@@ -269,7 +295,8 @@ public:
       operator != (
          const BoxContainerConstIterator& other) const
       {
-         return d_ordered ? d_set_iter != other.d_set_iter :
+         return d_compact ? d_vector_iter != other.d_vector_iter :
+                d_ordered ? d_set_iter != other.d_set_iter :
                 d_list_iter != other.d_list_iter;
       }
 
@@ -303,7 +330,14 @@ private:
        */
       std::set<Box *, Box::id_less>::const_iterator d_set_iter;
 
+      /*
+       * Underlying iterator to be used when compact.
+       */
+      std::vector<Box>::const_iterator d_vector_iter;
+
       bool d_ordered;
+
+      bool d_compact;
    };
 
    /*!
@@ -348,7 +382,10 @@ public:
       {
          if (this != &rhs) {
             d_ordered = rhs.d_ordered;
-            if (d_ordered) {
+            d_compact = rhs.d_compact;
+            if (d_compact) {
+               d_vector_iter = rhs.d_vector_iter;
+            } else if (d_ordered) {
                d_set_iter = rhs.d_set_iter;
             } else {
                d_list_iter = rhs.d_list_iter;
@@ -370,7 +407,8 @@ public:
       Box&
       operator * () const
       {
-         return d_ordered ? **d_set_iter : *d_list_iter;
+         return d_compact ? *d_vector_iter :
+                d_ordered ? **d_set_iter : *d_list_iter;
       }
 
       /*!
@@ -381,7 +419,8 @@ public:
       Box *
       operator -> () const
       {
-         return d_ordered ? *d_set_iter : &(*d_list_iter);
+         return d_compact ? &(*d_vector_iter) :
+                d_ordered ? *d_set_iter : &(*d_list_iter);
       }
 
       /*!
@@ -395,7 +434,9 @@ public:
          int)
       {
          BoxContainerIterator return_iter(*this);
-         if (d_ordered) {
+         if (d_compact) {
+            ++d_vector_iter;
+         } else if (d_ordered) {
             ++d_set_iter;
          } else {
             ++d_list_iter;
@@ -412,7 +453,9 @@ public:
       const BoxContainerIterator&
       operator ++ ()
       {
-         if (d_ordered) {
+         if (d_compact) {
+            ++d_vector_iter;
+         } else if (d_ordered) {
             ++d_set_iter;
          } else {
             ++d_list_iter;
@@ -431,7 +474,9 @@ public:
          int)
       {
          BoxContainerIterator return_iter(*this);
-         if (d_ordered) {
+         if (d_compact) {
+            --d_vector_iter;
+         } else if (d_ordered) {
             --d_set_iter;
          } else {
             --d_list_iter;
@@ -448,7 +493,9 @@ public:
       const BoxContainerIterator&
       operator -- ()
       {
-         if (d_ordered) {
+         if (d_compact) {
+            --d_vector_iter;
+         } else if (d_ordered) {
             --d_set_iter;
          } else {
             --d_list_iter;
@@ -467,7 +514,8 @@ public:
       operator == (
          const BoxContainerIterator& other) const
       {
-         return d_ordered ? d_set_iter == other.d_set_iter :
+         return d_compact ? d_vector_iter == other.d_vector_iter :
+                d_ordered ? d_set_iter == other.d_set_iter :
                 d_list_iter == other.d_list_iter;
       }
 
@@ -475,7 +523,8 @@ public:
       operator == (
          const BoxContainerConstIterator& other) const
       {
-         return d_ordered ? d_set_iter == other.d_set_iter :
+         return d_compact ? d_vector_iter == other.d_vector_iter :
+                d_ordered ? d_set_iter == other.d_set_iter :
                 d_list_iter == other.d_list_iter;
       }
 
@@ -490,7 +539,8 @@ public:
       operator != (
          const BoxContainerIterator& other) const
       {
-         return d_ordered ? d_set_iter != other.d_set_iter :
+         return d_compact ? d_vector_iter != other.d_vector_iter :
+                d_ordered ? d_set_iter != other.d_set_iter :
                 d_list_iter != other.d_list_iter;
       }
 
@@ -498,7 +548,8 @@ public:
       operator != (
          const BoxContainerConstIterator& other) const
       {
-         return d_ordered ? d_set_iter != other.d_set_iter :
+         return d_compact ? d_vector_iter != other.d_vector_iter :
+                d_ordered ? d_set_iter != other.d_set_iter :
                 d_list_iter != other.d_list_iter;
       }
 
@@ -532,8 +583,15 @@ private:
        */
       std::set<Box *, Box::id_less>::iterator d_set_iter;
 
+      /*
+       * Underlying iterator to be used when compact.
+       */
+      std::vector<Box>::iterator d_vector_iter;
+
       bool d_ordered;
 
+      bool d_compact;
+
    };
 
    /*!
@@ -662,7 +720,9 @@ private:
    int
    size() const
    {
-      if (!d_ordered) {
+      if (d_compact) {
+         return static_cast<int>(d_vector.size());
+      } else if (!d_ordered) {
          return static_cast<int>(d_list.size());
       } else {
          return static_cast<int>(d_set.size());
@@ -694,7 +754,7 @@ private:
    bool
    empty() const
    {
-      return d_list.empty();
+      return d_compact ? d_vector.empty() : d_list.empty();
    }
 
    /*!
@@ -817,7 +877,8 @@ private:
    const Box&
    front() const
    {
-      return d_ordered ? **(d_set.begin()) : d_list.front();
+      return d_compact ? d_vector.front() :
+             d_ordered ? **(d_set.begin()) : d_list.front();
    }
 
    /*!
@@ -828,13 +889,15 @@ private:
    const Box&
    back() const
    {
-      return d_ordered ? **(d_set.rbegin()) : d_list.back();
+      return d_compact ? d_vector.back() :
+             d_ordered ? **(d_set.rbegin()) : d_list.back();
    }
 
    /*!
     * @brief Remove the member of the container pointed to by "iter".
     *
-    * Can be called on ordered or unordered containers.
+    * Can be called on ordered or unordered containers.  A compact
+    * container is first returned to the default ordered storage.
     *
     * @param[in] iter
     */
@@ -866,7 +929,9 @@ private:
    {
       d_list.clear();
       d_set.clear();
+      d_vector.clear();
       d_ordered = false;
+      d_compact = false;
       d_tree.reset();
    }
 
@@ -884,9 +949,13 @@ private:
    {
       d_list.swap(other.d_list);
       d_set.swap(other.d_set);
+      d_vector.swap(other.d_vector);
       bool other_set_created = other.d_ordered;
       other.d_ordered = d_ordered;
       d_ordered = other_set_created;
+      bool other_compact = other.d_compact;
+      other.d_compact = d_compact;
+      d_compact = other_compact;
       d_tree.swap(other.d_tree);
    }
 
@@ -1027,6 +1096,40 @@ private:
       return d_ordered;
    }
 
+   /*!
+    * @brief Changes storage of this container to a single array sorted
+    * by BoxId.
+    *
+    * The container is ordered first if it is not already.  If called on
+    * a container that is already compact, nothing changes.  Invalidates
+    * all iterators into the container.
+    *
+    * @pre each box in container must have valid and unique BoxId
+    */
+   void
+   compact();
+
+   /*!
+    * @brief Changes storage of this container from compact back to the
+    * default ordered storage.
+    *
+    * The container remains ordered.  Methods that insert Boxes call this
+    * as needed.  Invalidates all iterators into the container.
+    */
+   void
+   uncompact();
+
+   /*!
+    * @brief Return whether this container is compact.
+    *
+    * @return  True if compact, false otherwise.
+    */
+   bool
+   isCompact() const
+   {
+      return d_compact;
+   }
+
    //@}
 
    //@{ Methods that may only be called on unordered containers.
@@ -1587,8 +1690,19 @@ private:
          TBOX_ERROR("find attempted on unordered BoxContainer." << std::endl);
       }
       iterator iter;
-      iter.d_set_iter = d_set.find(const_cast<Box *>(&box));
       iter.d_ordered = true;
+      if (d_compact) {
+         std::vector<Box>& boxes = const_cast<std::vector<Box>&>(d_vector);
+         iter.d_compact = true;
+         iter.d_vector_iter = std::lower_bound(boxes.begin(), boxes.end(),
+               box, Box::id_less());
+         if (iter.d_vector_iter != boxes.end() &&
+             iter.d_vector_iter->getBoxId() != box.getBoxId()) {
+            iter.d_vector_iter = boxes.end();
+         }
+         return iter;
+      }
+      iter.d_set_iter = d_set.find(const_cast<Box *>(&box));
       return iter;
    }
 
@@ -1613,8 +1727,15 @@ private:
          TBOX_ERROR("lowerBound attempted on unordered BoxContainer." << std::endl);
       }
       iterator iter;
-      iter.d_set_iter = d_set.lower_bound(const_cast<Box *>(&box));
       iter.d_ordered = true;
+      if (d_compact) {
+         std::vector<Box>& boxes = const_cast<std::vector<Box>&>(d_vector);
+         iter.d_compact = true;
+         iter.d_vector_iter = std::lower_bound(boxes.begin(), boxes.end(),
+               box, Box::id_less());
+         return iter;
+      }
+      iter.d_set_iter = d_set.lower_bound(const_cast<Box *>(&box));
       return iter;
    }
 
@@ -1638,8 +1759,15 @@ private:
          TBOX_ERROR("upperBound attempted on unordered BoxContainer." << std::endl);
       }
       iterator iter;
-      iter.d_set_iter = d_set.upper_bound(const_cast<Box *>(&box));
       iter.d_ordered = true;
+      if (d_compact) {
+         std::vector<Box>& boxes = const_cast<std::vector<Box>&>(d_vector);
+         iter.d_compact = true;
+         iter.d_vector_iter = std::upper_bound(boxes.begin(), boxes.end(),
+               box, Box::id_less());
+         return iter;
+      }
+      iter.d_set_iter = d_set.upper_bound(const_cast<Box *>(&box));
       return iter;
    }
 
@@ -1650,6 +1778,9 @@ private:
     * it will be erased from the container.  If no such member is found,
     * the container is unchanged.
     *
+    * A compact container is first returned to the default ordered
+    * storage.
+    *
     * @return  1 if a Box is erased, 0 otherwise.
     *
     * @param[in]  box  Box serving as key to find a Box to be erased.
@@ -1917,6 +2048,36 @@ private:
       const BaseGridGeometry* grid_geometry = 0,
       const int min_number = 10) const;
 
+   /*!
+    * @brief Select the kind of search tree built by makeTree().
+    *
+    * By default makeTree() builds a BoxTree for each block.  With
+    * use_flat_tree set, it builds a FlatBoxTree instead, a bounding
+    * volume hierarchy held in contiguous arrays that is faster to
+    * search for large numbers of boxes.  Both give the same overlaps,
+    * though possibly in a different order.  Trees that already exist
+    * are not changed.
+    *
+    * The default is false.  It may also be set with the
+    * use_flat_search_tree key of the OverlapConnectorAlgorithm input
+    * database.
+    */
+   static void
+   setUseFlatSearchTree(
+      bool use_flat_tree)
+   {
+      s_use_flat_search_tree = use_flat_tree;
+   }
+
+   /*!
+    * @brief Whether makeTree() builds FlatBoxTrees.
+    */
+   static bool
+   getUseFlatSearchTree()
+   {
+      return s_use_flat_search_tree;
+   }
+
    /*!
     * @brief Query if the search tree representation exists.
     */
@@ -2023,6 +2184,33 @@ private:
       const IntVector& refinement_ratio,
       bool include_singularity_block_neighbors = false) const;
 
+   /*!
+    * @brief Find the boxes intersecting each of a set of boxes.
+    *
+    * Pointers to the Boxes in this BoxContainer intersecting boxes[i]
+    * are appended to overlap_boxes, where they occupy positions
+    * overlap_offsets[i] to overlap_offsets[i+1]-1.  Answering a batch
+    * of searches in one call avoids per-search overhead, and with a
+    * FlatBoxTree (see setUseFlatSearchTree()) keeps the tree in cache
+    * between searches.
+    *
+    * All boxes in this container and in the argument must have the same
+    * BlockId.
+    *
+    * @param[out] overlap_boxes
+    *
+    * @param[out] overlap_offsets Resized to boxes.size()+1.
+    *
+    * @param[in] boxes
+    *
+    * @pre !hasTree() || (d_tree->getNumberBlocksInTree() == 1)
+    */
+   void
+   findOverlapBoxes(
+      std::vector<const Box *>& overlap_boxes,
+      std::vector<int>& overlap_offsets,
+      const std::vector<Box>& boxes) const;
+
    /*!
     * @brief Determine if a given box intersects with the BoxContainer.
     *
@@ -2049,6 +2237,11 @@ private:
     */
    static const int HIER_BOX_CONTAINER_VERSION;
 
+   /*
+    * Whether makeTree() builds FlatBoxTrees instead of BoxTrees.
+    */
+   static bool s_use_flat_search_tree;
+
    /*!
     * @brief Remove from each box portions intersecting boxes in takeaway.
     *
@@ -2142,6 +2335,22 @@ private:
       iterator& sublist_end,
       iterator& insertion_pt);
 
+   /*!
+    * @brief Remove the Boxes in [first, last) from the compact storage.
+    *
+    * @pre isCompact()
+    */
+   void
+   eraseCompact(
+      std::vector<Box>::iterator first,
+      std::vector<Box>::iterator last);
+
+   /*!
+    * @brief Lock the BoxIds of all Boxes in the compact storage.
+    */
+   void
+   lockCompactIds();
+
    /*!
     * List that provides the internal storage for the member Boxes.
     */
@@ -2153,8 +2362,16 @@ private:
     */
    std::set<Box *, Box::id_less> d_set;
 
+   /*!
+    * Array of Boxes sorted by BoxId used for compact containers.  When
+    * compact, d_list and d_set are empty.
+    */
+   std::vector<Box> d_vector;
+
    bool d_ordered;
 
+   bool d_compact;
+
    mutable std::shared_ptr<MultiblockBoxTree> d_tree;
 };
 
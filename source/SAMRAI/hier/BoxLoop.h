@@ -0,0 +1,380 @@
+/*************************************************************************
+ *
+ * This file is part of the SAMRAI distribution.  For full copyright
+ * information, see COPYRIGHT and LICENSE.
+ *
+ * Copyright:     (c) 1997-2017 Lawrence Livermore National Security, LLC
+ * Description:   Loops over the cells of a box with compile-time dimension.
+ *
+ ************************************************************************/
+
+#ifndef included_hier_BoxLoop
+#define included_hier_BoxLoop
+
+#include "SAMRAI/SAMRAI_config.h"
+#include "SAMRAI/hier/Box.h"
+#include "SAMRAI/tbox/Utilities.h"
+
+#include <type_traits>
+
+namespace SAMRAI {
+namespace hier {
+
+/**
+ * Class BoxLoop provides loops over the cells of a Box in which the
+ * dimension is a template parameter, so the index arithmetic is unrolled
+ * by the compiler instead of looping over a runtime Dimension as
+ * BoxContainer iterators and pdat::CellIterator do.  Each loop also has
+ * an overload without the template parameter that dispatches once on
+ * the dimension of the box.
+ *
+ * The cells are visited in rows: runs of cells along the first
+ * coordinate direction, which are contiguous in SAMRAI array data.
+ * Loop bodies may be lambdas or function objects.
+ *
+ * A row body passed to forEachRow() or parallelForEachRow() provides
+ * @code
+ *    void operator () (const int* index, int length);
+ * @endcode
+ * where index holds the dim coordinates of the first cell of the row
+ * and length is the number of cells in the row.  Writing the body as a
+ * loop over the row gives the compiler a contiguous inner loop it can
+ * vectorize.  A cell body passed to forEachIndex() provides
+ * @code
+ *    void operator () (const int* index);
+ * @endcode
+ * and is called for every cell.  In both cases index is only valid
+ * during the call.
+ *
+ * parallelForEachRow() splits the rows into tiles of consecutive rows
+ * that are distributed over OpenMP threads when SAMRAI is compiled with
+ * OpenMP, so its body must be safe to call concurrently for different
+ * rows.  Without OpenMP it is the same as forEachRow().
+ *
+ * For example, to zero the cells of a 3d box in an array whose box has
+ * lower corner lo and widths w:
+ * @code
+ *    hier::BoxLoop::forEachRow<3>(box,
+ *       [&](const int* index, int length) {
+ *          double* row = ptr + (index[0] - lo[0])
+ *             + w[0] * ((index[1] - lo[1]) + w[1] * (index[2] - lo[2]));
+ *          for (int i = 0; i < length; ++i) {
+ *             row[i] = 0.0;
+ *          }
+ *       });
+ * @endcode
+ */
+
+class BoxLoop
+{
+public:
+   /**
+    * Call a row body for each row of box, in order.
+    *
+    * @pre box.getDim().getValue() == DIM
+    */
+   template<int DIM, class BODY>
+   static void
+   forEachRow(
+      const Box& box,
+      BODY&& body)
+   {
+      TBOX_ASSERT(box.getDim().getValue() == DIM);
+      walkRows<DIM>(box, 0, getNumberOfRows(box), body);
+   }
+
+   /**
+    * Call a row body for each row of box, in order, dispatching on the
+    * dimension of box.
+    */
+   template<class BODY>
+   static void
+   forEachRow(
+      const Box& box,
+      BODY&& body)
+   {
+      dispatchRows(box, body,
+         std::integral_constant<int, SAMRAI::MAX_DIM_VAL>());
+   }
+
+   /**
+    * Call a cell body for each cell of box, in the same order as a
+    * BoxContainer iterator.
+    *
+    * @pre box.getDim().getValue() == DIM
+    */
+   template<int DIM, class BODY>
+   static void
+   forEachIndex(
+      const Box& box,
+      BODY&& body)
+   {
+      TBOX_ASSERT(box.getDim().getValue() == DIM);
+      IndexBody<DIM, BODY> rows(body);
+      walkRows<DIM>(box, 0, getNumberOfRows(box), rows);
+   }
+
+   /**
+    * Call a cell body for each cell of box, dispatching on the dimension
+    * of box.
+    */
+   template<class BODY>
+   static void
+   forEachIndex(
+      const Box& box,
+      BODY&& body)
+   {
+      dispatchIndices(box, body,
+         std::integral_constant<int, SAMRAI::MAX_DIM_VAL>());
+   }
+
+   /**
+    * Call a row body for each row of box, distributing tiles of
+    * tile_rows consecutive rows over threads.  If tile_rows is not
+    * positive, tiles of about getDefaultTileCells() cells are used.
+    *
+    * @pre box.getDim().getValue() == DIM
+    */
+   template<int DIM, class BODY>
+   static void
+   parallelForEachRow(
+      const Box& box,
+      const BODY& body,
+      int tile_rows = 0)
+   {
+      TBOX_ASSERT(box.getDim().getValue() == DIM);
+      const long num_rows = getNumberOfRows(box);
+      if (num_rows == 0) {
+         return;
+      }
+      long rows_per_tile = tile_rows;
+      if (rows_per_tile <= 0) {
+         rows_per_tile = getDefaultTileCells() / box.numberCells(0);
+         if (rows_per_tile < 1) {
+            rows_per_tile = 1;
+         }
+      }
+      const long num_tiles = (num_rows + rows_per_tile - 1) / rows_per_tile;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) if (num_tiles > 1)
+#endif
+      for (long t = 0; t < num_tiles; ++t) {
+         const long first = t * rows_per_tile;
+         const long end = first + rows_per_tile < num_rows ?
+            first + rows_per_tile : num_rows;
+         walkRows<DIM>(box, first, end, body);
+      }
+   }
+
+   /**
+    * Call a row body for each row of box, distributing tiles of rows
+    * over threads and dispatching on the dimension of box.
+    */
+   template<class BODY>
+   static void
+   parallelForEachRow(
+      const Box& box,
+      const BODY& body,
+      int tile_rows = 0)
+   {
+      dispatchParallelRows(box, body, tile_rows,
+         std::integral_constant<int, SAMRAI::MAX_DIM_VAL>());
+   }
+
+   /**
+    * Return the number of rows of box, zero if it is empty.
+    */
+   static long
+   getNumberOfRows(
+      const Box& box)
+   {
+      if (box.empty()) {
+         return 0;
+      }
+      return static_cast<long>(box.size() / box.numberCells(0));
+   }
+
+   /**
+    * Return the default number of cells in a tile of
+    * parallelForEachRow().
+    */
+   static int
+   getDefaultTileCells()
+   {
+      return 16384;
+   }
+
+private:
+   BoxLoop();                         // not implemented
+   ~BoxLoop();                        // not implemented
+
+   /*
+    * Adapts a cell body to a row body.
+    */
+   template<int DIM, class BODY>
+   class IndexBody
+   {
+public:
+      explicit IndexBody(
+         BODY& body):
+         d_body(body)
+      {
+      }
+
+      void
+      operator () (
+         const int* index,
+         int length)
+      {
+         int cell[SAMRAI::MAX_DIM_VAL];
+         for (int d = 1; d < DIM; ++d) {
+            cell[d] = index[d];
+         }
+         const int end = index[0] + length;
+         for (cell[0] = index[0]; cell[0] < end; ++cell[0]) {
+            d_body(static_cast<const int *>(cell));
+         }
+      }
+
+private:
+      BODY& d_body;
+   };
+
+   /*
+    * Call body for rows [first_row, end_row) of box.  Rows are numbered
+    * with the second direction varying fastest.
+    */
+   template<int DIM, class BODY>
+   static void
+   walkRows(
+      const Box& box,
+      long first_row,
+      long end_row,
+      BODY& body)
+   {
+      if (first_row >= end_row) {
+         return;
+      }
+      /*
+       * index is sized for any dimension so that bodies which loop over
+       * the runtime dimension of their arrays may read it safely.
+       */
+      int lower[DIM];
+      int upper[DIM];
+      int index[SAMRAI::MAX_DIM_VAL];
+      for (int d = 0; d < DIM; ++d) {
+         lower[d] = box.lower(static_cast<tbox::Dimension::dir_t>(d));
+         upper[d] = box.upper(static_cast<tbox::Dimension::dir_t>(d));
+      }
+      for (int d = DIM; d < SAMRAI::MAX_DIM_VAL; ++d) {
+         index[d] = 0;
+      }
+      const int length = upper[0] - lower[0] + 1;
+
+      index[0] = lower[0];
+      long r = first_row;
+      for (int d = 1; d < DIM; ++d) {
+         const long width = upper[d] - lower[d] + 1;
+         index[d] = lower[d] + static_cast<int>(r % width);
+         r /= width;
+      }
+
+      for (long row = first_row; row < end_row; ++row) {
+         body(static_cast<const int *>(index), length);
+         for (int d = 1; d < DIM; ++d) {
+            if (index[d] < upper[d]) {
+               ++index[d];
+               break;
+            }
+            index[d] = lower[d];
+         }
+      }
+   }
+
+   /*
+    * Dispatch on the dimension of box, counting down from MAX_DIM_VAL.
+    */
+   template<class BODY>
+   static void
+   dispatchRows(
+      const Box& box,
+      BODY&,
+      std::integral_constant<int, 0>)
+   {
+      TBOX_ERROR("BoxLoop: unsupported dimension "
+         << box.getDim().getValue() << std::endl);
+   }
+
+   template<int DIM, class BODY>
+   static void
+   dispatchRows(
+      const Box& box,
+      BODY& body,
+      std::integral_constant<int, DIM>)
+   {
+      if (box.getDim().getValue() == DIM) {
+         walkRows<DIM>(box, 0, getNumberOfRows(box), body);
+      } else {
+         dispatchRows(box, body, std::integral_constant<int, DIM - 1>());
+      }
+   }
+
+   template<class BODY>
+   static void
+   dispatchIndices(
+      const Box& box,
+      BODY&,
+      std::integral_constant<int, 0>)
+   {
+      TBOX_ERROR("BoxLoop: unsupported dimension "
+         << box.getDim().getValue() << std::endl);
+   }
+
+   template<int DIM, class BODY>
+   static void
+   dispatchIndices(
+      const Box& box,
+      BODY& body,
+      std::integral_constant<int, DIM>)
+   {
+      if (box.getDim().getValue() == DIM) {
+         forEachIndex<DIM>(box, body);
+      } else {
+         dispatchIndices(box, body, std::integral_constant<int, DIM - 1>());
+      }
+   }
+
+   template<class BODY>
+   static void
+   dispatchParallelRows(
+      const Box& box,
+      const BODY&,
+      int,
+      std::integral_constant<int, 0>)
+   {
+      TBOX_ERROR("BoxLoop: unsupported dimension "
+         << box.getDim().getValue() << std::endl);
+   }
+
+   template<int DIM, class BODY>
+   static void
+   dispatchParallelRows(
+      const Box& box,
+      const BODY& body,
+      int tile_rows,
+      std::integral_constant<int, DIM>)
+   {
+      if (box.getDim().getValue() == DIM) {
+         parallelForEachRow<DIM>(box, body, tile_rows);
+      } else {
+         dispatchParallelRows(box, body, tile_rows,
+            std::integral_constant<int, DIM - 1>());
+      }
+   }
+
+};
+
+}
+}
+
+#endif
@@ -35,6 +35,23 @@ namespace hier {
  * neighborhood of the base Box.  This class describes the neighborhoods of a
  * collection of base Boxes.  Each base Box in the collection has a
  * neighborhood of adjacent head Boxes.
+ *
+ * The collection has two representations.  The default, built by the
+ * insert and erase methods, keeps pools of base BoxIds and head Boxes
+ * linked by ordered sets of pointers.  compress() converts it to
+ * compressed sparse row form: the sorted base BoxIds, an array of
+ * offsets, one head index per relationship and a contiguous array of
+ * the distinct head Boxes.  The compressed form uses a fraction of the
+ * memory and is much faster to iterate, so it suits collections that
+ * are no longer changing.
+ *
+ * Iteration, searches and queries work in either form.  Methods that
+ * change the neighborhoods first convert the collection back to the
+ * default form, except coarsenNeighbors(), refineNeighbors() and
+ * growNeighbors(), which work on the compressed head Boxes directly.
+ * Converting between forms invalidates all iterators into the
+ * collection except the one passed to the method causing the
+ * conversion, which is updated.
  */
 class BoxNeighborhoodCollection
 {
@@ -129,6 +146,38 @@ private:
     */
    HeadBoxLinkCt d_nbr_link_ct;
 
+   /*!
+    * @brief Whether the collection is in compressed sparse row form.
+    *
+    * When true, the four members above are empty and the neighborhoods
+    * are held in the d_csr_* members below.
+    */
+   bool d_compressed;
+
+   /*!
+    * @brief Sorted BoxIds of the base Boxes in compressed form.
+    */
+   std::vector<BoxId> d_csr_base_ids;
+
+   /*!
+    * @brief Neighborhood offsets in compressed form.  The neighbors of
+    * base Box i are at positions d_csr_offsets[i] to
+    * d_csr_offsets[i+1]-1 of d_csr_nbr_indices.
+    */
+   std::vector<int> d_csr_offsets;
+
+   /*!
+    * @brief Index into d_csr_heads of each relationship's head Box, in
+    * increasing order within each neighborhood.
+    */
+   std::vector<int> d_csr_nbr_indices;
+
+   /*!
+    * @brief The distinct head Boxes in compressed form, sorted by
+    * BoxId.
+    */
+   std::vector<Box> d_csr_heads;
+
 public:
    // Constructors.
 
@@ -252,6 +301,7 @@ public:
          d_collection = rhs.d_collection;
          d_itr = rhs.d_itr;
          d_base_boxes_itr = rhs.d_base_boxes_itr;
+         d_index = rhs.d_index;
          return *this;
       }
 
@@ -267,6 +317,7 @@ public:
          d_collection = rhs.d_collection;
          d_itr = rhs.d_itr;
          d_base_boxes_itr = rhs.d_base_boxes_itr;
+         d_index = rhs.d_index;
          return *this;
       }
 
@@ -286,7 +337,8 @@ public:
       const BoxId&
       operator * () const
       {
-         return *(d_itr->first);
+         return d_collection->d_compressed ?
+                d_collection->d_csr_base_ids[d_index] : *(d_itr->first);
       }
 
       /*!
@@ -296,7 +348,8 @@ public:
       const BoxId *
       operator -> () const
       {
-         return d_itr->first;
+         return d_collection->d_compressed ?
+                &d_collection->d_csr_base_ids[d_index] : d_itr->first;
       }
 
       /*!
@@ -309,10 +362,7 @@ public:
       {
          // Go to the next base Box.
          ConstIterator tmp = *this;
-         if (d_base_boxes_itr != d_collection->d_base_boxes.end()) {
-            ++d_base_boxes_itr;
-            ++d_itr;
-         }
+         ++(*this);
          return tmp;
       }
 
@@ -324,7 +374,12 @@ public:
       operator ++ ()
       {
          // Go to the next base Box.
-         if (d_base_boxes_itr != d_collection->d_base_boxes.end()) {
+         if (d_collection->d_compressed) {
+            if (d_index <
+                static_cast<int>(d_collection->d_csr_base_ids.size())) {
+               ++d_index;
+            }
+         } else if (d_base_boxes_itr != d_collection->d_base_boxes.end()) {
             ++d_base_boxes_itr;
             ++d_itr;
          }
@@ -340,9 +395,12 @@ public:
       operator == (
          const ConstIterator& rhs) const
       {
-         return d_collection == rhs.d_collection &&
-                d_itr == rhs.d_itr &&
-                d_base_boxes_itr == rhs.d_base_boxes_itr;
+         if (d_collection != rhs.d_collection) {
+            return false;
+         }
+         return d_collection->d_compressed ?
+                d_index == rhs.d_index :
+                d_itr == rhs.d_itr && d_base_boxes_itr == rhs.d_base_boxes_itr;
       }
 
       /*!
@@ -373,11 +431,27 @@ private:
          const BoxNeighborhoodCollection& nbrhds,
          AdjListConstItr itr);
 
+      /*!
+       * @brief Constructs an iterator pointing to the base Box at a
+       * given position of a compressed nbrhds.  Should only be called
+       * by BoxNeighborhoodCollection.
+       *
+       * @param nbrhds
+       *
+       * @param index
+       */
+      ConstIterator(
+         const BoxNeighborhoodCollection& nbrhds,
+         int index);
+
       const BoxNeighborhoodCollection* d_collection;
 
       AdjListConstItr d_itr;
 
       BaseBoxPoolItr d_base_boxes_itr;
+
+      // Position of the base Box in the compressed form.
+      int d_index;
    };
 
    class NeighborIterator;
@@ -428,6 +502,7 @@ public:
          d_collection = rhs.d_collection;
          d_itr = rhs.d_itr;
          d_base_boxes_itr = rhs.d_base_boxes_itr;
+         d_index = rhs.d_index;
          return *this;
       }
 
@@ -447,7 +522,8 @@ public:
       const BoxId&
       operator * () const
       {
-         return *(d_itr->first);
+         return d_collection->d_compressed ?
+                d_collection->d_csr_base_ids[d_index] : *(d_itr->first);
       }
 
       /*!
@@ -457,7 +533,8 @@ public:
       const BoxId *
       operator -> () const
       {
-         return d_itr->first;
+         return d_collection->d_compressed ?
+                &d_collection->d_csr_base_ids[d_index] : d_itr->first;
       }
 
       /*!
@@ -470,10 +547,7 @@ public:
       {
          // Go to the next base Box.
          Iterator tmp = *this;
-         if (d_base_boxes_itr != d_collection->d_base_boxes.end()) {
-            ++d_base_boxes_itr;
-            ++d_itr;
-         }
+         ++(*this);
          return tmp;
       }
 
@@ -485,7 +559,12 @@ public:
       operator ++ ()
       {
          // Go to the next base Box.
-         if (d_base_boxes_itr != d_collection->d_base_boxes.end()) {
+         if (d_collection->d_compressed) {
+            if (d_index <
+                static_cast<int>(d_collection->d_csr_base_ids.size())) {
+               ++d_index;
+            }
+         } else if (d_base_boxes_itr != d_collection->d_base_boxes.end()) {
             ++d_base_boxes_itr;
             ++d_itr;
          }
@@ -501,9 +580,12 @@ public:
       operator == (
          const Iterator& rhs) const
       {
-         return d_collection == rhs.d_collection &&
-                d_itr == rhs.d_itr &&
-                d_base_boxes_itr == rhs.d_base_boxes_itr;
+         if (d_collection != rhs.d_collection) {
+            return false;
+         }
+         return d_collection->d_compressed ?
+                d_index == rhs.d_index :
+                d_itr == rhs.d_itr && d_base_boxes_itr == rhs.d_base_boxes_itr;
       }
 
       /*!
@@ -534,11 +616,27 @@ private:
          BoxNeighborhoodCollection& nbrhds,
          AdjListItr itr);
 
+      /*!
+       * @brief Constructs an iterator pointing to the base Box at a
+       * given position of a compressed nbrhds.  Should only be called
+       * by BoxNeighborhoodCollection.
+       *
+       * @param nbrhds
+       *
+       * @param index
+       */
+      Iterator(
+         BoxNeighborhoodCollection& nbrhds,
+         int index);
+
       const BoxNeighborhoodCollection* d_collection;
 
       AdjListItr d_itr;
 
       BaseBoxPoolItr d_base_boxes_itr;
+
+      // Position of the base Box in the compressed form.
+      int d_index;
    };
 
    /*!
@@ -601,6 +699,8 @@ public:
          d_collection = rhs.d_collection;
          d_base_box = rhs.d_base_box;
          d_itr = rhs.d_itr;
+         d_index = rhs.d_index;
+         d_end = rhs.d_end;
          return *this;
       }
 
@@ -616,6 +716,8 @@ public:
          d_collection = rhs.d_collection;
          d_base_box = rhs.d_base_box;
          d_itr = rhs.d_itr;
+         d_index = rhs.d_index;
+         d_end = rhs.d_end;
          return *this;
       }
 
@@ -635,7 +737,9 @@ public:
       const Box&
       operator * () const
       {
-         return *(*d_itr);
+         return d_collection->d_compressed ?
+                d_collection->d_csr_heads[
+                   d_collection->d_csr_nbr_indices[d_index]] : *(*d_itr);
       }
 
       /*!
@@ -645,7 +749,7 @@ public:
       const Box *
       operator -> () const
       {
-         return *d_itr;
+         return &(**this);
       }
 
       /*!
@@ -657,9 +761,7 @@ public:
          int)
       {
          ConstNeighborIterator tmp = *this;
-         if (d_itr != d_collection->d_adj_list.find(d_base_box)->second.end()) {
-            ++d_itr;
-         }
+         ++(*this);
          return tmp;
       }
 
@@ -670,7 +772,12 @@ public:
       ConstNeighborIterator&
       operator ++ ()
       {
-         if (d_itr != d_collection->d_adj_list.find(d_base_box)->second.end()) {
+         if (d_collection->d_compressed) {
+            if (d_index < d_end) {
+               ++d_index;
+            }
+         } else if (d_itr !=
+                    d_collection->d_adj_list.find(d_base_box)->second.end()) {
             ++d_itr;
          }
          return *this;
@@ -685,9 +792,12 @@ public:
       operator == (
          const ConstNeighborIterator& rhs) const
       {
-         return d_collection == rhs.d_collection &&
-                d_base_box == rhs.d_base_box &&
-                d_itr == rhs.d_itr;
+         if (d_collection != rhs.d_collection ||
+             d_base_box != rhs.d_base_box) {
+            return false;
+         }
+         return d_collection->d_compressed ?
+                d_index == rhs.d_index : d_itr == rhs.d_itr;
       }
 
       /*!
@@ -711,6 +821,12 @@ private:
       const BoxId* d_base_box;
 
       NeighborhoodConstItr d_itr;
+
+      // Position of the current neighbor in the compressed form and the
+      // end of the base Box's neighborhood.
+      int d_index;
+
+      int d_end;
    };
 
    /*!
@@ -760,6 +876,8 @@ public:
          d_collection = rhs.d_collection;
          d_base_box = rhs.d_base_box;
          d_itr = rhs.d_itr;
+         d_index = rhs.d_index;
+         d_end = rhs.d_end;
          return *this;
       }
 
@@ -779,7 +897,9 @@ public:
       const Box&
       operator * () const
       {
-         return *(*d_itr);
+         return d_collection->d_compressed ?
+                d_collection->d_csr_heads[
+                   d_collection->d_csr_nbr_indices[d_index]] : *(*d_itr);
       }
 
       /*!
@@ -789,7 +909,7 @@ public:
       const Box *
       operator -> () const
       {
-         return *d_itr;
+         return &(**this);
       }
 
       /*!
@@ -801,9 +921,7 @@ public:
          int)
       {
          NeighborIterator tmp = *this;
-         if (d_itr != d_collection->d_adj_list.find(d_base_box)->second.end()) {
-            ++d_itr;
-         }
+         ++(*this);
          return tmp;
       }
 
@@ -814,7 +932,12 @@ public:
       NeighborIterator&
       operator ++ ()
       {
-         if (d_itr != d_collection->d_adj_list.find(d_base_box)->second.end()) {
+         if (d_collection->d_compressed) {
+            if (d_index < d_end) {
+               ++d_index;
+            }
+         } else if (d_itr !=
+                    d_collection->d_adj_list.find(d_base_box)->second.end()) {
             ++d_itr;
          }
          return *this;
@@ -829,9 +952,12 @@ public:
       operator == (
          const NeighborIterator& rhs) const
       {
-         return d_collection == rhs.d_collection &&
-                d_base_box == rhs.d_base_box &&
-                d_itr == rhs.d_itr;
+         if (d_collection != rhs.d_collection ||
+             d_base_box != rhs.d_base_box) {
+            return false;
+         }
+         return d_collection->d_compressed ?
+                d_index == rhs.d_index : d_itr == rhs.d_itr;
       }
 
       /*!
@@ -855,6 +981,12 @@ private:
       const BoxId* d_base_box;
 
       NeighborhoodItr d_itr;
+
+      // Position of the current neighbor in the compressed form and the
+      // end of the base Box's neighborhood.
+      int d_index;
+
+      int d_end;
    };
 
    /*!
@@ -1041,6 +1173,9 @@ private:
    find(
       const BoxId& base_box_id) const
    {
+      if (d_compressed) {
+         return ConstIterator(*this, findCompressedIndex(base_box_id));
+      }
       BaseBoxPoolItr base_boxes_itr = d_base_boxes.find(base_box_id);
       if (base_boxes_itr == d_base_boxes.end()) {
          return end();
@@ -1060,6 +1195,9 @@ private:
    find(
       const BoxId& base_box_id)
    {
+      if (d_compressed) {
+         return Iterator(*this, findCompressedIndex(base_box_id));
+      }
       BaseBoxPoolItr base_boxes_itr = d_base_boxes.find(base_box_id);
       if (base_boxes_itr == d_base_boxes.end()) {
          return end();
@@ -1084,7 +1222,7 @@ private:
    bool
    empty() const
    {
-      return d_base_boxes.empty();
+      return d_compressed ? d_csr_base_ids.empty() : d_base_boxes.empty();
    }
 
    /*!
@@ -1093,7 +1231,8 @@ private:
    int
    numBoxNeighborhoods() const
    {
-      return static_cast<int>(d_base_boxes.size());
+      return static_cast<int>(d_compressed ?
+                              d_csr_base_ids.size() : d_base_boxes.size());
    }
 
    /*!
@@ -1124,6 +1263,10 @@ private:
    {
       TBOX_ASSERT(base_box_itr.d_collection == this);
       TBOX_ASSERT(base_box_itr != end());
+      if (d_compressed) {
+         return d_csr_offsets[base_box_itr.d_index] ==
+                d_csr_offsets[base_box_itr.d_index + 1];
+      }
       return base_box_itr.d_itr->second.empty();
    }
 
@@ -1155,6 +1298,10 @@ private:
    {
       TBOX_ASSERT(base_box_itr.d_collection == this);
       TBOX_ASSERT(base_box_itr != end());
+      if (d_compressed) {
+         return d_csr_offsets[base_box_itr.d_index + 1]
+                - d_csr_offsets[base_box_itr.d_index];
+      }
       return static_cast<int>(base_box_itr.d_itr->second.size());
    }
 
@@ -1505,6 +1652,54 @@ private:
 
    //@}
 
+   //@{
+   /*!
+    * @name Representation
+    */
+
+   /*!
+    * @brief Converts the collection to compressed sparse row form.
+    *
+    * Use this once a collection is complete to reduce its memory and
+    * speed up iteration.  Invalidates all iterators into the
+    * collection.  A no-op if the collection is already compressed.
+    */
+   void
+   compress();
+
+   /*!
+    * @brief Converts the collection back to its default, editable form.
+    *
+    * Methods that change the neighborhoods call this as needed so it is
+    * rarely called directly.  Invalidates all iterators into the
+    * collection.  A no-op if the collection is not compressed.
+    */
+   void
+   uncompress();
+
+   /*!
+    * @brief Returns true if the collection is in compressed sparse row
+    * form.
+    */
+   bool
+   isCompressed() const
+   {
+      return d_compressed;
+   }
+
+   /*!
+    * @brief Returns an estimate of the memory, in bytes, used by the
+    * collection.
+    *
+    * For the default form the estimate assumes each set or map node
+    * costs four pointers in addition to its value.  For the compressed
+    * form it is the capacity of the arrays.
+    */
+   size_t
+   getMemoryUsage() const;
+
+   //@}
+
    //@{
    /*!
     * @name Coarsen, refine, grow.
@@ -1679,6 +1874,27 @@ private:
       tbox::Database& restart_db);
 
    //@}
+
+private:
+   /*!
+    * @brief Returns the position of base_box_id in the compressed form,
+    * or the number of base Boxes if it is not there.
+    *
+    * @pre d_compressed
+    */
+   int
+   findCompressedIndex(
+      const BoxId& base_box_id) const;
+
+   /*!
+    * @brief Uncompresses the collection and updates base_box_itr to
+    * point to the same base Box in the default form.
+    *
+    * @param base_box_itr
+    */
+   void
+   uncompress(
+      Iterator& base_box_itr);
 };
 
 }
@@ -710,6 +710,43 @@ public:
       d_relationships.growNeighbors(growth);
    }
 
+   /*!
+    * @brief Store the relationships in compressed sparse row form.
+    *
+    * Saves memory and speeds iteration for a Connector that is no longer
+    * being modified.  Later modifications still work but first convert
+    * the relationships back.  Invalidates iterators into the
+    * relationships.
+    *
+    * @see BoxNeighborhoodCollection::compress()
+    */
+   void
+   compressRelationships()
+   {
+      d_relationships.compress();
+      d_global_relationships.compress();
+   }
+
+   /*!
+    * @brief Returns true if the local relationships are stored in
+    * compressed sparse row form.
+    */
+   bool
+   relationshipsAreCompressed() const
+   {
+      return d_relationships.isCompressed();
+   }
+
+   /*!
+    * @brief Returns an estimate of the memory, in bytes, used to store
+    * the local relationships.
+    */
+   size_t
+   getLocalRelationshipMemoryUsage() const
+   {
+      return d_relationships.getMemoryUsage();
+   }
+
    //@}
 
    /*!
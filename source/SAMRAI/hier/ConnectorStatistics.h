@@ -34,11 +34,15 @@ public:
     * collective communication.
     *
     * @param[in] connector
+    * @param[in] time_relationship_visits Whether to time one pass
+    * through the local relationships.  The pass visits every
+    * relationship, so it is off by default.
     *
     * @pre connector.isFinalized()
     */
    explicit ConnectorStatistics(
-      const Connector& connector);
+      const Connector& connector,
+      bool time_relationship_visits = false);
 
    /*!
     * @brief Print out local and globally reduced statistics on the
@@ -85,6 +89,12 @@ private:
     * local base boxes.  When we compute the global min/max of these
     * quantities, that is exactly what they are: min of min, min of
     * max, max of min and max of max.
+    *
+    * The storage and visit-time quantities describe how the local
+    * relationships are stored (see Connector::compressRelationships())
+    * and are measured, not derived from the Connector's contents.  The
+    * visit time is only measured and printed when requested in the
+    * constructor.
     */
    enum { NUMBER_OF_BASE_BOXES,
           NUMBER_OF_BASE_CELLS,
@@ -106,6 +116,10 @@ private:
           LOCAL_OVERLAP_SIZE,
           REMOTE_OVERLAP_SIZE,
 
+          RELATIONSHIP_STORAGE_BYTES,
+          BYTES_PER_RELATIONSHIP,
+          NANOSECONDS_PER_RELATIONSHIP_VISIT,
+
           NUMBER_OF_QUANTITIES };
 
    /*
@@ -129,6 +143,9 @@ private:
 
    tbox::SAMRAI_MPI d_mpi;
 
+   //! @brief Whether NANOSECONDS_PER_RELATIONSHIP_VISIT is measured.
+   bool d_time_relationship_visits;
+
    //! @brief Statistics of local process.
    StatisticalQuantities d_sq;
    //! @brief Global min of d_sq.
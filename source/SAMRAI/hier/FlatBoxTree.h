@@ -0,0 +1,256 @@
+/*************************************************************************
+ *
+ * This file is part of the SAMRAI distribution.  For full copyright
+ * information, see COPYRIGHT and LICENSE.
+ *
+ * Copyright:     (c) 1997-2017 Lawrence Livermore National Security, LLC
+ * Description:   Bounding volume hierarchy of Boxes in contiguous arrays.
+ *
+ ************************************************************************/
+
+#ifndef included_hier_FlatBoxTree
+#define included_hier_FlatBoxTree
+
+#include "SAMRAI/SAMRAI_config.h"
+
+#include "SAMRAI/hier/Box.h"
+#include "SAMRAI/tbox/Timer.h"
+
+#include <vector>
+#include <list>
+#include <memory>
+
+namespace SAMRAI {
+namespace hier {
+
+class BoxContainer;
+
+/*!
+ * @brief Bounding volume hierarchy of Boxes for finding box overlaps,
+ * stored in contiguous arrays.
+ *
+ * FlatBoxTree is an alternative to BoxTree answering the same overlap
+ * queries.  Instead of a tree of heap-allocated nodes each holding a
+ * list of box pointers, it keeps
+ * - the tree nodes in one vector, in depth-first order, so a left child
+ *   immediately follows its parent;
+ * - the lower and upper corners of the boxes in structure-of-arrays
+ *   form, one contiguous run of integers per direction, ordered so that
+ *   each leaf covers a contiguous range.
+ *
+ * Every box is assigned to exactly one leaf.  Nodes are split at the
+ * median box center along the longest direction of the node's bounding
+ * box until no more than min_number boxes remain, so the tree is
+ * balanced and sibling bounding boxes may overlap.
+ *
+ * Searches walk the tree with an explicit stack and test leaf boxes
+ * with a loop over the coordinate arrays.  A batched search answers
+ * many queries with one call, writing the results in compressed rows.
+ *
+ * All boxes in a FlatBoxTree must exist in the same index space; they
+ * must all have the same BlockId.  Like BoxTree, the interface is
+ * private and the class is used through MultiblockBoxTree, which
+ * builds it when BoxContainer::setUseFlatSearchTree(true) is in effect.
+ *
+ * @see BoxTree
+ */
+
+class FlatBoxTree
+{
+   friend class MultiblockBoxTree;
+
+public:
+   /*!
+    * @brief Destructor.
+    */
+   ~FlatBoxTree();
+
+private:
+   /*!
+    * @brief Constructs a FlatBoxTree from a set of Boxes.
+    *
+    * @param[in] boxes
+    *
+    * @param[in] min_number Maximum number of boxes in a leaf.
+    * @b Default: 10
+    *
+    * @pre !boxes.empty()
+    * @pre for each box in boxes, !box.empty()
+    * @pre each box in boxes has a valid, identical BlockId
+    */
+   explicit FlatBoxTree(
+      const std::list<const Box *>& boxes,
+      int min_number = 10);
+
+   /*
+    * Unimplemented default constructor, copy constructor and assignment
+    * operator.
+    */
+   FlatBoxTree();
+
+   FlatBoxTree(
+      const FlatBoxTree& other);
+
+   FlatBoxTree&
+   operator = (
+      const FlatBoxTree& rhs);
+
+   /*!
+    * @brief Return the dimension of the boxes in the tree.
+    */
+   const tbox::Dimension&
+   getDim() const
+   {
+      return d_dim;
+   }
+
+   const BlockId&
+   getBlockId() const
+   {
+      return d_block_id;
+   }
+
+   /*!
+    * @brief Whether the given box has an overlap with Boxes in the tree.
+    *
+    * @pre getDim() == box.getDim()
+    */
+   bool
+   hasOverlap(
+      const Box& box) const;
+
+   /*!
+    * @brief Append pointers to all Boxes overlapping the given box.
+    *
+    * @pre getDim() == box.getDim()
+    * @pre box.getBlockId() == getBlockId()
+    */
+   void
+   findOverlapBoxes(
+      std::vector<const Box *>& overlap_boxes,
+      const Box& box) const;
+
+   /*!
+    * @brief Add all Boxes overlapping the given box to a BoxContainer,
+    * keeping its ordered/unordered state.
+    *
+    * @pre getDim() == box.getDim()
+    * @pre box.getBlockId() == getBlockId()
+    */
+   void
+   findOverlapBoxes(
+      BoxContainer& overlap_boxes,
+      const Box& box) const;
+
+   /*!
+    * @brief Find the overlaps of each of a set of boxes.
+    *
+    * The overlaps of boxes[i] are appended to overlap_boxes and
+    * occupy positions overlap_offsets[i] to overlap_offsets[i+1]-1.
+    * overlap_offsets is resized to boxes.size()+1, and
+    * overlap_offsets[0] is the size of overlap_boxes on entry.
+    *
+    * @pre for each box in boxes, box.getBlockId() == getBlockId()
+    */
+   void
+   findOverlapBoxes(
+      std::vector<const Box *>& overlap_boxes,
+      std::vector<int>& overlap_offsets,
+      const std::vector<Box>& boxes) const;
+
+   /*!
+    * @brief A node of the hierarchy.
+    *
+    * An interior node's left child is the next node in d_nodes and
+    * its right child is at d_right.  A leaf has d_right < 0 and owns
+    * boxes d_begin to d_end-1.
+    */
+   struct Node {
+      int d_lower[SAMRAI::MAX_DIM_VAL];
+      int d_upper[SAMRAI::MAX_DIM_VAL];
+      int d_begin;
+      int d_end;
+      int d_right;
+   };
+
+   /*!
+    * @brief Recursively build the nodes for boxes d_boxes[begin..end-1],
+    * reordering d_boxes, and return the index of the node.
+    *
+    * @param depth Depth of the new node, the root having depth 1.
+    */
+   int
+   buildNode(
+      int begin,
+      int end,
+      int min_number,
+      int depth);
+
+   /*!
+    * @brief Search the tree, calling the functor for the index (into
+    * d_boxes) of every overlapping box.  The functor returns false to
+    * stop the search.
+    */
+   template<class FUNCTOR>
+   void
+   search(
+      const Box& box,
+      FUNCTOR& functor) const;
+
+   /*!
+    * @brief Set up static class members.
+    *
+    * Only called by StartupShutdownManager.
+    */
+   static void
+   initializeCallback();
+
+   /*!
+    * @brief Free static timers.
+    *
+    * Only called by StartupShutdownManager.
+    */
+   static void
+   finalizeCallback();
+
+   const tbox::Dimension d_dim;
+
+   BlockId d_block_id;
+
+   /*!
+    * @brief Nodes in depth-first order.  The root is d_nodes[0].
+    */
+   std::vector<Node> d_nodes;
+
+   /*!
+    * @brief Boxes in leaf order.
+    */
+   std::vector<const Box *> d_boxes;
+
+   /*!
+    * @brief Box corners in structure-of-arrays form.  The lower corner
+    * of box i in direction d is d_box_lower[d * num_boxes + i].
+    */
+   std::vector<int> d_box_lower;
+   std::vector<int> d_box_upper;
+
+   /*!
+    * @brief Depth of the tree, bounding the search stack size.
+    */
+   int d_depth;
+
+   /*
+    * Timers are static to keep the objects light-weight.
+    */
+   static std::shared_ptr<tbox::Timer> t_build_tree[SAMRAI::MAX_DIM_VAL];
+   static std::shared_ptr<tbox::Timer> t_search[SAMRAI::MAX_DIM_VAL];
+
+   static tbox::StartupShutdownManager::Handler
+      s_initialize_finalize_handler;
+
+};
+
+}
+}
+
+#endif
@@ -26,6 +26,36 @@ namespace hier {
  * to a BoxLevel.
  *
  * MappingConnectorAlgorithm objects check and apply mappings.
+ *
+ * <b> Input Parameters </b> <br>
+ * Read from the "MappingConnectorAlgorithm" database of the input
+ * database, if it exists.
+ *
+ * <b> Definitions: </b>
+ *   - \b    num_threads
+ *      Number of threads used to discover overlaps.  0 selects the OpenMP
+ *      default, which respects OMP_NUM_THREADS.  Changed for one object
+ *      with setNumberOfThreads().
+ *
+ * <b> Details: </b> <br>
+ * <table>
+ *   <tr>
+ *     <th>parameter</th>
+ *     <th>type</th>
+ *     <th>default</th>
+ *     <th>range</th>
+ *     <th>opt/req</th>
+ *     <th>behavior on restart</th>
+ *   </tr>
+ *   <tr>
+ *     <td>num_threads</td>
+ *     <td>int</td>
+ *     <td>0</td>
+ *     <td>>=0</td>
+ *     <td>opt</td>
+ *     <td>Not written to restart.  Value in input file used.</td>
+ *   </tr>
+ * </table>
  */
 class MappingConnectorAlgorithm:public BaseConnectorAlgorithm
 {
@@ -360,7 +390,8 @@ private:
       const IntVector& refinement_ratio) const;
 
    /*!
-    * @brief Read extra debugging flag from input database.
+    * @brief Read the thread count and extra debugging flags from the
+    * input database.
     */
    void
    getFromInput();
@@ -390,6 +421,9 @@ private:
    // Extra checks independent of optimization/debug.
    static char s_print_steps;
 
+   //! @brief Default number of threads, read from input.
+   static int s_num_threads;
+
    /*
     * @brief Border for debugging output.
     */
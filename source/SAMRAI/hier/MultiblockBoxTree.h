@@ -14,6 +14,7 @@
 #include "SAMRAI/SAMRAI_config.h"
 
 #include "SAMRAI/hier/BoxTree.h"
+#include "SAMRAI/hier/FlatBoxTree.h"
 
 #include <vector>
 #include <map>
@@ -27,8 +28,8 @@ class BoxContainer;
 
 /*!
  * @brief Utility sorting Boxes into tree-like form for finding
- * box overlaps.  Boxes are sorted by BlockId and then a BoxTree is constructed
- * for each block in a BoxContainer.
+ * box overlaps.  Boxes are sorted by BlockId and then a BoxTree, or a
+ * FlatBoxTree if requested, is constructed for each block in a BoxContainer.
  *
  * Except for a destructor needed by boost shared_ptr, the entire interface is
  * private.  This class is intended to be only used by BoxContainer, which
@@ -59,12 +60,16 @@ private:
     * larger value tends to make tree building faster but tree
     * searching slower, and vice versa.  @b Default: 10
     *
+    * @param[in] use_flat_tree Build a FlatBoxTree for each block
+    * instead of a BoxTree.  @b Default: false
+    *
     * @pre for each box in boxes, box.getBlockId().isValid()
     */
    MultiblockBoxTree(
       const BoxContainer& boxes,
       const BaseGridGeometry* grid_geometry,
-      const int min_number = 10);
+      const int min_number = 10,
+      bool use_flat_tree = false);
 
    /*!
     * Default constructor is unimplemented and should not be used.
@@ -80,7 +85,9 @@ private:
       const BlockId& block_id) const
    {
       return d_single_block_trees.find(block_id) !=
-             d_single_block_trees.end();
+             d_single_block_trees.end() ||
+             d_single_block_flat_trees.find(block_id) !=
+             d_single_block_flat_trees.end();
    }
 
    /*!
@@ -89,7 +96,8 @@ private:
    int
    getNumberBlocksInTree() const
    {
-      return static_cast<int>(d_single_block_trees.size());
+      return static_cast<int>(d_single_block_trees.size()
+                              + d_single_block_flat_trees.size());
    }
 
    const BaseGridGeometry *
@@ -107,6 +115,7 @@ private:
    clear()
    {
       d_single_block_trees.clear();
+      d_single_block_flat_trees.clear();
    }
 
    //@{
@@ -240,17 +249,57 @@ private:
       const IntVector& refinement_ratio,
       bool include_singularity_block_neighbors = false) const;
 
+   /*!
+    * @brief Find the boxes intersecting each of a set of boxes.
+    *
+    * The overlaps of boxes[i] are appended to overlap_boxes and occupy
+    * positions overlap_offsets[i] to overlap_offsets[i+1]-1.
+    *
+    * This only works if the tree represents Boxes all having the same
+    * BlockId as the argument boxes.
+    *
+    * @param[out] overlap_boxes
+    *
+    * @param[out] overlap_offsets Resized to boxes.size()+1.
+    *
+    * @param[in] boxes
+    *
+    * @pre getNumberBlocksInTree() == 1
+    */
+   void
+   findOverlapBoxes(
+      std::vector<const Box *>& overlap_boxes,
+      std::vector<int>& overlap_offsets,
+      const std::vector<Box>& boxes) const;
+
    //@}
 
 private:
+   /*!
+    * @brief Search the tree of one block, of either kind, for overlaps
+    * of a box in that block's index space.
+    */
+   template<class OUTPUT>
+   void
+   findOverlapBoxesInBlock(
+      OUTPUT& overlap_boxes,
+      const BlockId& block_id,
+      const Box& box) const;
+
    /*!
     * @brief Container of single-block BoxTrees.
     *
     * For each BlockId represented in the tree, there is
-    * an entry in this container.
+    * an entry in this container, or in d_single_block_flat_trees if
+    * the tree was built with use_flat_tree.
     */
    std::map<BlockId, std::shared_ptr<BoxTree> > d_single_block_trees;
 
+   /*!
+    * @brief Container of single-block FlatBoxTrees.
+    */
+   std::map<BlockId, std::shared_ptr<FlatBoxTree> > d_single_block_flat_trees;
+
    const BaseGridGeometry* d_grid_geometry;
 };
 
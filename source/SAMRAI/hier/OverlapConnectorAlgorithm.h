@@ -32,6 +32,51 @@ namespace hier {
  *
  * OverlapConnectorAlgorithm objects create, check and operate on overlap
  * Connectors.
+ *
+ * <b> Input Parameters </b> <br>
+ * Read from the "OverlapConnectorAlgorithm" database of the input
+ * database, if it exists.
+ *
+ * <b> Definitions: </b>
+ *   - \b    num_threads
+ *      Number of threads used to discover overlaps.  0 selects the OpenMP
+ *      default, which respects OMP_NUM_THREADS.  Changed for one object
+ *      with setNumberOfThreads().
+ *
+ *   - \b    use_flat_search_tree
+ *      Whether BoxContainer::makeTree() builds a FlatBoxTree instead of a
+ *      BoxTree for each block.  This is a setting for the whole process,
+ *      applied when the first OverlapConnectorAlgorithm is constructed and
+ *      only if given in the input; see
+ *      BoxContainer::setUseFlatSearchTree().
+ *
+ * <b> Details: </b> <br>
+ * <table>
+ *   <tr>
+ *     <th>parameter</th>
+ *     <th>type</th>
+ *     <th>default</th>
+ *     <th>range</th>
+ *     <th>opt/req</th>
+ *     <th>behavior on restart</th>
+ *   </tr>
+ *   <tr>
+ *     <td>num_threads</td>
+ *     <td>int</td>
+ *     <td>0</td>
+ *     <td>>=0</td>
+ *     <td>opt</td>
+ *     <td>Not written to restart.  Value in input file used.</td>
+ *   </tr>
+ *   <tr>
+ *     <td>use_flat_search_tree</td>
+ *     <td>bool</td>
+ *     <td>FALSE</td>
+ *     <td>TRUE, FALSE</td>
+ *     <td>opt</td>
+ *     <td>Not written to restart.  Value in input file used.</td>
+ *   </tr>
+ * </table>
  */
 class OverlapConnectorAlgorithm:public BaseConnectorAlgorithm
 {
@@ -48,7 +93,8 @@ public:
    virtual ~OverlapConnectorAlgorithm();
 
    /*!
-    * @brief Read extra debugging flag from input database.
+    * @brief Read the thread count and extra debugging flags from the
+    * input database.
     */
    void
    getFromInput();
@@ -682,6 +728,9 @@ private:
    // Extra checks independent of optimization/debug.
    static char s_print_steps;
 
+   //! @brief Default number of threads, read from input.
+   static int s_num_threads;
+
    /*!
     * @brief Tag to use (and increment) at begining of operations that
     * require nearest-neighbor communication, to aid in eliminating
@@ -15,6 +15,7 @@
 
 #include "SAMRAI/hier/PatchDataFactory.h"
 #include "SAMRAI/hier/IntVector.h"
+#include "SAMRAI/tbox/MemoryAllocator.h"
 #include "SAMRAI/tbox/PIO.h"
 #include "SAMRAI/tbox/Utilities.h"
 
@@ -53,6 +54,11 @@ namespace hier {
  * See the documentation of the SAMRAIManager utility for information about
  * changing this maximum value.
  *
+ * A component may be given its own tbox::MemoryAllocator with
+ * setComponentAllocator().  Array-based patch data of the component is
+ * then allocated from it, overriding the allocator of the patch level and
+ * the global default.
+ *
  * @see tbox::SAMRAIManager
  * @see PatchDataFactory
  * @see PatchDataData
@@ -144,6 +150,42 @@ public:
    getPatchDataFactory(
       const std::string& name) const;
 
+   /*!
+    * Set the allocator for the array storage of the patch data component
+    * with the given index.  A null pointer removes the component's
+    * allocator, so the level or global default allocator is used.  The
+    * allocator is removed with the component by removePatchDataComponent().
+    *
+    * @param id        int index of the component.
+    * @param allocator Allocator used for data of the component.
+    *
+    * @pre (id >= 0) && (id < getMaxNumberRegisteredComponents())
+    */
+   void
+   setComponentAllocator(
+      int id,
+      const std::shared_ptr<tbox::MemoryAllocator>& allocator)
+   {
+      TBOX_ASSERT((id >= 0) && (id < d_max_number_registered_components));
+      d_allocators[id] = allocator;
+   }
+
+   /*!
+    * Retrieve the allocator of the patch data component with the given
+    * index, which is null if the component has no allocator of its own.
+    *
+    * @param id      int index of the component.
+    *
+    * @pre (id >= 0) && (id < getMaxNumberRegisteredComponents())
+    */
+   const std::shared_ptr<tbox::MemoryAllocator>&
+   getComponentAllocator(
+      int id) const
+   {
+      TBOX_ASSERT((id >= 0) && (id < d_max_number_registered_components));
+      return d_allocators[id];
+   }
+
    /*!
     * Get the maximum number of components currently known to the patch
     * descriptor.  That is, this number indicates the largest number of
@@ -250,6 +292,7 @@ private:
    int d_max_number_registered_components;
    std::vector<std::string> d_names;
    std::vector<std::shared_ptr<PatchDataFactory> > d_factories;
+   std::vector<std::shared_ptr<tbox::MemoryAllocator> > d_allocators;
    std::list<int> d_free_indices;
 
    /*!
@@ -17,6 +17,7 @@
 #include "SAMRAI/hier/BoxLevel.h"
 #include "SAMRAI/hier/PatchFactory.h"
 #include "SAMRAI/hier/ProcessorMapping.h"
+#include "SAMRAI/tbox/MemoryAllocator.h"
 #include "SAMRAI/tbox/Utilities.h"
 
 #include <map>
@@ -744,6 +745,35 @@ public:
       return getPatch(box_id)->getPatchGeometry()->getTouchesRegularBoundary();
    }
 
+   /*!
+    * @brief Set the allocator for the array-based patch data of this level.
+    *
+    * Patch data allocated through this level's allocatePatchData()
+    * functions uses the allocator, unless the patch data component has an
+    * allocator of its own (see PatchDescriptor::setComponentAllocator()).
+    * Data allocated directly on a Patch does not use it.
+    *
+    * @param[in]  allocator
+    */
+   void
+   setAllocator(
+      const std::shared_ptr<tbox::MemoryAllocator>& allocator)
+   {
+      d_allocator = allocator;
+   }
+
+   /*!
+    * @brief Return the allocator for the array-based patch data of this
+    * level.
+    *
+    * If no allocator has been set and the level is in a hierarchy, an
+    * arena with chunks of tbox::SAMRAIManager::getLevelArenaChunkBytes()
+    * is created when that value is non-zero.  Otherwise the return value
+    * is null and the global default allocator is used.
+    */
+   const std::shared_ptr<tbox::MemoryAllocator>&
+   getAllocator();
+
    /*!
     * @brief Allocate the specified component on all patches.
     *
@@ -755,6 +785,7 @@ public:
       const int id,
       const double timestamp = 0.0)
    {
+      tbox::MemoryAllocator::Scope scope(getAllocator());
       for (Iterator ip(begin()); ip != end(); ++ip) {
          ip->allocatePatchData(id, timestamp);
       }
@@ -772,6 +803,7 @@ public:
       const ComponentSelector& components,
       const double timestamp = 0.0)
    {
+      tbox::MemoryAllocator::Scope scope(getAllocator());
       for (Iterator ip(begin()); ip != end(); ++ip) {
          ip->allocatePatchData(components, timestamp);
       }
@@ -1401,6 +1433,11 @@ private:
     */
    bool d_boundary_boxes_created;
 
+   /*
+    * Allocator for the array-based patch data of the level.
+    */
+   std::shared_ptr<tbox::MemoryAllocator> d_allocator;
+
    /*!
     * @brief Has shutdown handler been initialized.
     *
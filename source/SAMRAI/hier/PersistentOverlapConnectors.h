@@ -59,6 +59,13 @@ class BoxLevel;
  *      look for overlaps.  If "WARN", do the same thing but write a warning to
  *      the log.  If "ERROR", exit with an error.
  *
+ *    - \b compress_connectors
+ *      If TRUE, store the relationships of each Connector in compressed
+ *      sparse row form when it is added to the collection.  This reduces
+ *      the memory of cached Connectors and speeds up iterating over them.
+ *      Connectors that are modified afterwards are converted back
+ *      automatically.
+ *
  * <b> Details: </b> <br>
  * <table>
  *   <tr>
@@ -77,6 +84,14 @@ class BoxLevel;
  *     <td>opt</td>
  *     <td>Not read from restart</td>
  *   </tr>
+ *   <tr>
+ *     <td>compress_connectors</td>
+ *     <td>bool</td>
+ *     <td>FALSE</td>
+ *     <td>TRUE, FALSE</td>
+ *     <td>opt</td>
+ *     <td>Not read from restart</td>
+ *   </tr>
  * </table>
  *
  * @note Creating overlap Connectors by global search is not scalable
@@ -393,6 +408,14 @@ private:
     */
    static char s_implicit_connector_creation_rule;
 
+   /*!
+    * @brief Whether to compress the relationships of Connectors added
+    * to the collection.
+    *
+    * See input parameter compress_connectors.
+    */
+   static bool s_compress_connectors;
+
    /*
     * @brief Count of how many times we have done implicit global searches.
     */
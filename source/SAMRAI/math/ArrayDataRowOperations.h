@@ -0,0 +1,1015 @@
+/*************************************************************************
+ *
+ * This file is part of the SAMRAI distribution.  For full copyright
+ * information, see COPYRIGHT and LICENSE.
+ *
+ * Copyright:     (c) 1997-2017 Lawrence Livermore National Security, LLC
+ * Description:   Row and element operations for array data operations.
+ *
+ ************************************************************************/
+
+#ifndef included_math_ArrayDataRowOperations
+#define included_math_ArrayDataRowOperations
+
+#include "SAMRAI/SAMRAI_config.h"
+#include "SAMRAI/math/ArrayDataRows.h"
+#include "SAMRAI/tbox/MathUtilities.h"
+
+#include <cmath>
+
+namespace SAMRAI {
+namespace math {
+
+/*
+ *************************************************************************
+ *
+ * Row operations for ArrayDataRows.  Each holds the data pointers of up
+ * to three arrays and an element operation OP, and applies OP to the
+ * elements of a row.  T0, T1 and T2 are the element types of the arrays,
+ * const qualified when the array is only read.
+ *
+ * RowApply operations call OP on each element of the row:
+ * @code
+ *    void operator () (T0& e0, T1& e1, ...) const;
+ * @endcode
+ * The loop is marked for vectorization, so OP must not carry state
+ * from one element to the next.
+ *
+ * RowReduce operations combine the values OP returns for the elements
+ * of the row.  OP provides result_type, identity() and combine() as
+ * described in ArrayDataRows.  Four independent partial results are
+ * kept so the loop is not serialized on a single accumulator.
+ *
+ *************************************************************************
+ */
+
+template<class T0, class OP>
+class RowApply1
+{
+public:
+   RowApply1(
+      T0* p0,
+      const OP& op):
+      d_p0(p0),
+      d_op(op)
+   {
+   }
+
+   void
+   operator () (
+      const size_t* offsets,
+      size_t length) const
+   {
+      T0* const r0 = d_p0 + offsets[0];
+      SAMRAI_ROW_SIMD
+      for (size_t i = 0; i < length; ++i) {
+         d_op(r0[i]);
+      }
+   }
+
+private:
+   T0* const d_p0;
+   const OP d_op;
+};
+
+template<class T0, class T1, class OP>
+class RowApply2
+{
+public:
+   RowApply2(
+      T0* p0,
+      T1* p1,
+      const OP& op):
+      d_p0(p0),
+      d_p1(p1),
+      d_op(op)
+   {
+   }
+
+   void
+   operator () (
+      const size_t* offsets,
+      size_t length) const
+   {
+      T0* const r0 = d_p0 + offsets[0];
+      T1* const r1 = d_p1 + offsets[1];
+      SAMRAI_ROW_SIMD
+      for (size_t i = 0; i < length; ++i) {
+         d_op(r0[i], r1[i]);
+      }
+   }
+
+private:
+   T0* const d_p0;
+   T1* const d_p1;
+   const OP d_op;
+};
+
+template<class T0, class T1, class T2, class OP>
+class RowApply3
+{
+public:
+   RowApply3(
+      T0* p0,
+      T1* p1,
+      T2* p2,
+      const OP& op):
+      d_p0(p0),
+      d_p1(p1),
+      d_p2(p2),
+      d_op(op)
+   {
+   }
+
+   void
+   operator () (
+      const size_t* offsets,
+      size_t length) const
+   {
+      T0* const r0 = d_p0 + offsets[0];
+      T1* const r1 = d_p1 + offsets[1];
+      T2* const r2 = d_p2 + offsets[2];
+      SAMRAI_ROW_SIMD
+      for (size_t i = 0; i < length; ++i) {
+         d_op(r0[i], r1[i], r2[i]);
+      }
+   }
+
+private:
+   T0* const d_p0;
+   T1* const d_p1;
+   T2* const d_p2;
+   const OP d_op;
+};
+
+template<class T0, class OP>
+class RowReduce1
+{
+public:
+   typedef typename OP::result_type result_type;
+
+   RowReduce1(
+      T0* p0,
+      const OP& op):
+      d_p0(p0),
+      d_op(op)
+   {
+   }
+
+   result_type
+   identity() const
+   {
+      return d_op.identity();
+   }
+
+   result_type
+   combine(
+      const result_type& a,
+      const result_type& b) const
+   {
+      return d_op.combine(a, b);
+   }
+
+   result_type
+   operator () (
+      const size_t* offsets,
+      size_t length) const
+   {
+      T0* const r0 = d_p0 + offsets[0];
+      result_type a0 = d_op.identity();
+      result_type a1 = a0;
+      result_type a2 = a0;
+      result_type a3 = a0;
+      size_t i = 0;
+      for ( ; i + 4 <= length; i += 4) {
+         a0 = d_op.combine(a0, d_op(r0[i]));
+         a1 = d_op.combine(a1, d_op(r0[i + 1]));
+         a2 = d_op.combine(a2, d_op(r0[i + 2]));
+         a3 = d_op.combine(a3, d_op(r0[i + 3]));
+      }
+      for ( ; i < length; ++i) {
+         a0 = d_op.combine(a0, d_op(r0[i]));
+      }
+      return d_op.combine(d_op.combine(a0, a1), d_op.combine(a2, a3));
+   }
+
+private:
+   T0* const d_p0;
+   const OP d_op;
+};
+
+template<class T0, class T1, class OP>
+class RowReduce2
+{
+public:
+   typedef typename OP::result_type result_type;
+
+   RowReduce2(
+      T0* p0,
+      T1* p1,
+      const OP& op):
+      d_p0(p0),
+      d_p1(p1),
+      d_op(op)
+   {
+   }
+
+   result_type
+   identity() const
+   {
+      return d_op.identity();
+   }
+
+   result_type
+   combine(
+      const result_type& a,
+      const result_type& b) const
+   {
+      return d_op.combine(a, b);
+   }
+
+   result_type
+   operator () (
+      const size_t* offsets,
+      size_t length) const
+   {
+      T0* const r0 = d_p0 + offsets[0];
+      T1* const r1 = d_p1 + offsets[1];
+      result_type a0 = d_op.identity();
+      result_type a1 = a0;
+      result_type a2 = a0;
+      result_type a3 = a0;
+      size_t i = 0;
+      for ( ; i + 4 <= length; i += 4) {
+         a0 = d_op.combine(a0, d_op(r0[i], r1[i]));
+         a1 = d_op.combine(a1, d_op(r0[i + 1], r1[i + 1]));
+         a2 = d_op.combine(a2, d_op(r0[i + 2], r1[i + 2]));
+         a3 = d_op.combine(a3, d_op(r0[i + 3], r1[i + 3]));
+      }
+      for ( ; i < length; ++i) {
+         a0 = d_op.combine(a0, d_op(r0[i], r1[i]));
+      }
+      return d_op.combine(d_op.combine(a0, a1), d_op.combine(a2, a3));
+   }
+
+private:
+   T0* const d_p0;
+   T1* const d_p1;
+   const OP d_op;
+};
+
+template<class T0, class T1, class T2, class OP>
+class RowReduce3
+{
+public:
+   typedef typename OP::result_type result_type;
+
+   RowReduce3(
+      T0* p0,
+      T1* p1,
+      T2* p2,
+      const OP& op):
+      d_p0(p0),
+      d_p1(p1),
+      d_p2(p2),
+      d_op(op)
+   {
+   }
+
+   result_type
+   identity() const
+   {
+      return d_op.identity();
+   }
+
+   result_type
+   combine(
+      const result_type& a,
+      const result_type& b) const
+   {
+      return d_op.combine(a, b);
+   }
+
+   result_type
+   operator () (
+      const size_t* offsets,
+      size_t length) const
+   {
+      T0* const r0 = d_p0 + offsets[0];
+      T1* const r1 = d_p1 + offsets[1];
+      T2* const r2 = d_p2 + offsets[2];
+      result_type a0 = d_op.identity();
+      result_type a1 = a0;
+      result_type a2 = a0;
+      result_type a3 = a0;
+      size_t i = 0;
+      for ( ; i + 4 <= length; i += 4) {
+         a0 = d_op.combine(a0, d_op(r0[i], r1[i], r2[i]));
+         a1 = d_op.combine(a1, d_op(r0[i + 1], r1[i + 1], r2[i + 1]));
+         a2 = d_op.combine(a2, d_op(r0[i + 2], r1[i + 2], r2[i + 2]));
+         a3 = d_op.combine(a3, d_op(r0[i + 3], r1[i + 3], r2[i + 3]));
+      }
+      for ( ; i < length; ++i) {
+         a0 = d_op.combine(a0, d_op(r0[i], r1[i], r2[i]));
+      }
+      return d_op.combine(d_op.combine(a0, a1), d_op.combine(a2, a3));
+   }
+
+private:
+   T0* const d_p0;
+   T1* const d_p1;
+   T2* const d_p2;
+   const OP d_op;
+};
+
+/*
+ * Absolute value of real data.  Same as tbox::MathUtilities<TYPE>::Abs,
+ * which for float and double is compiled out of line and branches on
+ * the sign, but inline and branch free so that the row loops vectorize.
+ */
+template<class TYPE>
+inline TYPE
+absoluteValue(
+   const TYPE& a)
+{
+   return std::abs(a);
+}
+
+/*
+ *************************************************************************
+ *
+ * Bases for the element operations of reductions, supplying
+ * result_type, identity() and combine().
+ *
+ *************************************************************************
+ */
+
+template<class RESULT>
+class SumReduction
+{
+public:
+   typedef RESULT result_type;
+
+   RESULT
+   identity() const
+   {
+      return tbox::MathUtilities<RESULT>::getZero();
+   }
+
+   RESULT
+   combine(
+      const RESULT& a,
+      const RESULT& b) const
+   {
+      return a + b;
+   }
+};
+
+template<class RESULT>
+class MinReduction
+{
+public:
+   typedef RESULT result_type;
+
+   RESULT
+   identity() const
+   {
+      return tbox::MathUtilities<RESULT>::getMax();
+   }
+
+   RESULT
+   combine(
+      const RESULT& a,
+      const RESULT& b) const
+   {
+      return tbox::MathUtilities<RESULT>::Min(a, b);
+   }
+};
+
+/*
+ * Identity is -getMax(), the starting value of the maximum operations,
+ * not the most negative value of the type.
+ */
+template<class RESULT>
+class MaxReduction
+{
+public:
+   typedef RESULT result_type;
+
+   RESULT
+   identity() const
+   {
+      return -tbox::MathUtilities<RESULT>::getMax();
+   }
+
+   RESULT
+   combine(
+      const RESULT& a,
+      const RESULT& b) const
+   {
+      return tbox::MathUtilities<RESULT>::Max(a, b);
+   }
+};
+
+/*
+ * Maximum of values known to be non-negative, starting from zero.
+ */
+template<class RESULT>
+class MaxMagnitudeReduction
+{
+public:
+   typedef RESULT result_type;
+
+   RESULT
+   identity() const
+   {
+      return tbox::MathUtilities<RESULT>::getZero();
+   }
+
+   RESULT
+   combine(
+      const RESULT& a,
+      const RESULT& b) const
+   {
+      return a < b ? b : a;
+   }
+};
+
+/*
+ * Logical and of tests that are 1 (passed) or 0 (failed).
+ */
+class TestReduction
+{
+public:
+   typedef int result_type;
+
+   int
+   identity() const
+   {
+      return 1;
+   }
+
+   int
+   combine(
+      int a,
+      int b) const
+   {
+      return a < b ? a : b;
+   }
+};
+
+/*
+ *************************************************************************
+ *
+ * Element operations for ArrayDataBasicOps.
+ *
+ *************************************************************************
+ */
+
+template<class TYPE>
+class ScaleOp
+{
+public:
+   explicit ScaleOp(
+      const TYPE& alpha):
+      d_alpha(alpha)
+   {
+   }
+   void
+   operator () (
+      TYPE& dst,
+      const TYPE& src) const
+   {
+      dst = d_alpha * src;
+   }
+private:
+   const TYPE d_alpha;
+};
+
+template<class TYPE>
+class AddScalarOp
+{
+public:
+   explicit AddScalarOp(
+      const TYPE& alpha):
+      d_alpha(alpha)
+   {
+   }
+   void
+   operator () (
+      TYPE& dst,
+      const TYPE& src) const
+   {
+      dst = d_alpha + src;
+   }
+private:
+   const TYPE d_alpha;
+};
+
+template<class TYPE>
+class AddOp
+{
+public:
+   void
+   operator () (
+      TYPE& dst,
+      const TYPE& src1,
+      const TYPE& src2) const
+   {
+      dst = src1 + src2;
+   }
+};
+
+template<class TYPE>
+class SubtractOp
+{
+public:
+   void
+   operator () (
+      TYPE& dst,
+      const TYPE& src1,
+      const TYPE& src2) const
+   {
+      dst = src1 - src2;
+   }
+};
+
+template<class TYPE>
+class MultiplyOp
+{
+public:
+   void
+   operator () (
+      TYPE& dst,
+      const TYPE& src1,
+      const TYPE& src2) const
+   {
+      dst = src1 * src2;
+   }
+};
+
+template<class TYPE>
+class DivideOp
+{
+public:
+   void
+   operator () (
+      TYPE& dst,
+      const TYPE& src1,
+      const TYPE& src2) const
+   {
+      dst = src1 / src2;
+   }
+};
+
+template<class TYPE>
+class ReciprocalOp
+{
+public:
+   void
+   operator () (
+      TYPE& dst,
+      const TYPE& src) const
+   {
+      dst = tbox::MathUtilities<TYPE>::getOne() / src;
+   }
+};
+
+template<class TYPE>
+class LinearSumOp
+{
+public:
+   LinearSumOp(
+      const TYPE& alpha,
+      const TYPE& beta):
+      d_alpha(alpha),
+      d_beta(beta)
+   {
+   }
+   void
+   operator () (
+      TYPE& dst,
+      const TYPE& src1,
+      const TYPE& src2) const
+   {
+      dst = d_alpha * src1 + d_beta * src2;
+   }
+private:
+   const TYPE d_alpha;
+   const TYPE d_beta;
+};
+
+template<class TYPE>
+class AxpyOp
+{
+public:
+   explicit AxpyOp(
+      const TYPE& alpha):
+      d_alpha(alpha)
+   {
+   }
+   void
+   operator () (
+      TYPE& dst,
+      const TYPE& src1,
+      const TYPE& src2) const
+   {
+      dst = d_alpha * src1 + src2;
+   }
+private:
+   const TYPE d_alpha;
+};
+
+template<class TYPE>
+class AxmyOp
+{
+public:
+   explicit AxmyOp(
+      const TYPE& alpha):
+      d_alpha(alpha)
+   {
+   }
+   void
+   operator () (
+      TYPE& dst,
+      const TYPE& src1,
+      const TYPE& src2) const
+   {
+      dst = d_alpha * src1 - src2;
+   }
+private:
+   const TYPE d_alpha;
+};
+
+template<class TYPE>
+class MinOp:public MinReduction<TYPE>
+{
+public:
+   TYPE
+   operator () (
+      const TYPE& data) const
+   {
+      return data;
+   }
+};
+
+template<class TYPE>
+class MaxOp:public MaxReduction<TYPE>
+{
+public:
+   TYPE
+   operator () (
+      const TYPE& data) const
+   {
+      return data;
+   }
+};
+
+/*
+ * Random values are drawn in order from one generator, so this is a row
+ * operation to be used with ArrayDataRows::forEachRowInOrder() and is
+ * not vectorized.
+ */
+template<class TYPE>
+class RandomValuesRow
+{
+public:
+   RandomValuesRow(
+      TYPE* dst,
+      const TYPE& low,
+      const TYPE& width):
+      d_dst(dst),
+      d_low(low),
+      d_width(width)
+   {
+   }
+   void
+   operator () (
+      const size_t* offsets,
+      size_t length) const
+   {
+      TYPE* const r = d_dst + offsets[0];
+      for (size_t i = 0; i < length; ++i) {
+         r[i] = tbox::MathUtilities<TYPE>::Rand(d_low, d_width);
+      }
+   }
+private:
+   TYPE* const d_dst;
+   const TYPE d_low;
+   const TYPE d_width;
+};
+
+/*
+ *************************************************************************
+ *
+ * Element operations for ArrayDataNormOpsReal.
+ *
+ *************************************************************************
+ */
+
+template<class TYPE>
+class AbsOp
+{
+public:
+   void
+   operator () (
+      TYPE& dst,
+      const TYPE& src) const
+   {
+      dst = absoluteValue(src);
+   }
+};
+
+class SumControlVolumesOp:public SumReduction<double>
+{
+public:
+   double
+   operator () (
+      const double& cvol) const
+   {
+      return cvol;
+   }
+};
+
+template<class TYPE>
+class L1NormOp:public SumReduction<double>
+{
+public:
+   double
+   operator () (
+      const TYPE& data) const
+   {
+      return absoluteValue(data);
+   }
+};
+
+template<class TYPE>
+class L1NormWithControlVolumeOp:public SumReduction<double>
+{
+public:
+   double
+   operator () (
+      const TYPE& data,
+      const double& cvol) const
+   {
+      return absoluteValue(data) * cvol;
+   }
+};
+
+template<class TYPE>
+class WeightedL2NormOp:public SumReduction<double>
+{
+public:
+   double
+   operator () (
+      const TYPE& data,
+      const TYPE& weight) const
+   {
+      const TYPE val = data * weight;
+      return val * val;
+   }
+};
+
+template<class TYPE>
+class WeightedL2NormWithControlVolumeOp:public SumReduction<double>
+{
+public:
+   double
+   operator () (
+      const TYPE& data,
+      const TYPE& weight,
+      const double& cvol) const
+   {
+      const TYPE val = data * weight;
+      return val * val * cvol;
+   }
+};
+
+template<class TYPE>
+class MaxNormOp:public MaxMagnitudeReduction<double>
+{
+public:
+   double
+   operator () (
+      const TYPE& data) const
+   {
+      return absoluteValue(data);
+   }
+};
+
+template<class TYPE>
+class MaxNormWithControlVolumeOp:public MaxMagnitudeReduction<double>
+{
+public:
+   double
+   operator () (
+      const TYPE& data,
+      const double& cvol) const
+   {
+      return cvol > 0.0 ? absoluteValue(data) : 0.0;
+   }
+};
+
+template<class TYPE>
+class DotOp:public SumReduction<TYPE>
+{
+public:
+   TYPE
+   operator () (
+      const TYPE& data1,
+      const TYPE& data2) const
+   {
+      return data1 * data2;
+   }
+};
+
+template<class TYPE>
+class DotWithControlVolumeOp:public SumReduction<TYPE>
+{
+public:
+   TYPE
+   operator () (
+      const TYPE& data1,
+      const TYPE& data2,
+      const double& cvol) const
+   {
+      return static_cast<TYPE>(data1 * data2 * cvol);
+   }
+};
+
+template<class TYPE>
+class IntegralOp:public SumReduction<TYPE>
+{
+public:
+   TYPE
+   operator () (
+      const TYPE& data,
+      const double& vol) const
+   {
+      return static_cast<TYPE>(data * vol);
+   }
+};
+
+/*
+ *************************************************************************
+ *
+ * Element operations for ArrayDataMiscellaneousOpsReal.
+ *
+ *************************************************************************
+ */
+
+template<class TYPE>
+class ConstrProdPosOp:public TestReduction
+{
+public:
+   int
+   operator () (
+      const TYPE& data1,
+      const TYPE& data2) const
+   {
+      return (absoluteValue(data2) > 0.0
+              && data1 * data2 <= 0.0) ? 0 : 1;
+   }
+};
+
+template<class TYPE>
+class ConstrProdPosWithControlVolumeOp:public TestReduction
+{
+public:
+   int
+   operator () (
+      const TYPE& data1,
+      const TYPE& data2,
+      const double& cvol) const
+   {
+      return (cvol > 0.0
+              && absoluteValue(data2) > 0.0
+              && data1 * data2 <= 0.0) ? 0 : 1;
+   }
+};
+
+template<class TYPE>
+class CompareToScalarOp
+{
+public:
+   explicit CompareToScalarOp(
+      const TYPE& alpha):
+      d_alpha(alpha)
+   {
+   }
+   void
+   operator () (
+      TYPE& dst,
+      const TYPE& src) const
+   {
+      dst = (absoluteValue(src) >= d_alpha) ? 1.0F : 0.0F;
+   }
+private:
+   const TYPE d_alpha;
+};
+
+template<class TYPE>
+class CompareToScalarWithControlVolumeOp
+{
+public:
+   explicit CompareToScalarWithControlVolumeOp(
+      const TYPE& alpha):
+      d_alpha(alpha)
+   {
+   }
+   void
+   operator () (
+      TYPE& dst,
+      const TYPE& src,
+      const double& cvol) const
+   {
+      if (cvol > 0.0) {
+         dst = (absoluteValue(src) >= d_alpha) ? 1.0F : 0.0F;
+      }
+   }
+private:
+   const TYPE d_alpha;
+};
+
+/*
+ * Sets dst to the reciprocal of src, or to zero where src is zero,
+ * which fails the test.
+ */
+template<class TYPE>
+class TestReciprocalOp:public TestReduction
+{
+public:
+   int
+   operator () (
+      TYPE& dst,
+      const TYPE& src) const
+   {
+      if (src == 0.0) {
+         dst = 0.0F;
+         return 0;
+      }
+      dst = 1.0F / src;
+      return 1;
+   }
+};
+
+template<class TYPE>
+class TestReciprocalWithControlVolumeOp:public TestReduction
+{
+public:
+   int
+   operator () (
+      TYPE& dst,
+      const TYPE& src,
+      const double& cvol) const
+   {
+      if (cvol > 0.0) {
+         if (src == 0.0) {
+            dst = 0.0F;
+            return 0;
+         }
+         dst = 1.0F / src;
+      }
+      return 1;
+   }
+};
+
+/*
+ * |numer/denom|, or |numer| where denom is zero.
+ */
+template<class TYPE>
+class MaxPointwiseDivideOp:public MaxMagnitudeReduction<TYPE>
+{
+public:
+   TYPE
+   operator () (
+      const TYPE& numer,
+      const TYPE& denom) const
+   {
+      return denom == 0.0 ?
+             absoluteValue(numer) :
+             absoluteValue(numer / denom);
+   }
+};
+
+/*
+ * numer/denom, ignoring elements where denom is zero.
+ */
+template<class TYPE>
+class MinPointwiseDivideOp:public MinReduction<TYPE>
+{
+public:
+   TYPE
+   operator () (
+      const TYPE& numer,
+      const TYPE& denom) const
+   {
+      return denom != 0.0 ?
+             numer / denom : tbox::MathUtilities<TYPE>::getMax();
+   }
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,326 @@
+/*************************************************************************
+ *
+ * This file is part of the SAMRAI distribution.  For full copyright
+ * information, see COPYRIGHT and LICENSE.
+ *
+ * Copyright:     (c) 1997-2017 Lawrence Livermore National Security, LLC
+ * Description:   Row iteration over a box in several data arrays.
+ *
+ ************************************************************************/
+
+#ifndef included_math_ArrayDataRows
+#define included_math_ArrayDataRows
+
+#include "SAMRAI/SAMRAI_config.h"
+#include "SAMRAI/hier/Box.h"
+
+#include <vector>
+
+/*
+ * SAMRAI_ROW_SIMD, placed before the loop over the cells of a row, tells
+ * the compiler that iterations are independent so the loop should be
+ * vectorized.
+ */
+#if defined(_OPENMP) && (_OPENMP >= 201307)
+#define SAMRAI_ROW_SIMD _Pragma("omp simd")
+#elif defined(__clang__)
+#define SAMRAI_ROW_SIMD _Pragma("clang loop vectorize(enable)")
+#elif defined(__GNUC__) && !defined(__INTEL_COMPILER) && \
+   (__GNUC__ >= 5 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))
+#define SAMRAI_ROW_SIMD _Pragma("GCC ivdep")
+#else
+#define SAMRAI_ROW_SIMD
+#endif
+
+namespace SAMRAI {
+namespace math {
+
+/**
+ * Class ArrayDataRows drives the loops of the array data operations
+ * (ArrayDataBasicOps, ArrayDataNormOpsReal and
+ * ArrayDataMiscellaneousOpsReal).  These operate on a box in all depth
+ * components of one or more arrays.  The box splits into rows: runs of
+ * cells along the first coordinate direction, which are contiguous in
+ * every array.  An operation is applied row by row, so its inner loop
+ * is a plain loop over contiguous data that the compiler can vectorize.
+ *
+ * Row offsets are computed with 64-bit arithmetic, so arrays with more
+ * than 2^31 entries are handled.
+ *
+ * The rows are split into chunks of consecutive rows, and the chunking
+ * depends only on the box and depth.  When SAMRAI is compiled with
+ * OpenMP and there is more than one chunk, the chunks are processed by
+ * separate threads.  Reductions combine the results of the chunks in
+ * chunk order, so results do not depend on the number of threads.
+ *
+ * A row operation passed to forEachRow() or forEachRowInOrder() provides
+ * @code
+ *    void operator () (const size_t* offsets, size_t length) const;
+ * @endcode
+ * where offsets[a] is the offset of the row in array a, in the order
+ * the arrays were added.  A row operation passed to reduceRows() also
+ * provides
+ * @code
+ *    typedef ... result_type;
+ *    result_type identity() const;
+ *    result_type combine(const result_type& a, const result_type& b) const;
+ * @endcode
+ * and its operator() returns the result for the row.
+ */
+
+class ArrayDataRows
+{
+public:
+   /**
+    * Maximum number of arrays.
+    */
+   static const int MAX_ARRAYS = 4;
+
+   /**
+    * Set up the rows of a box in depth components.  The box must be
+    * contained in the box of each array added.
+    *
+    * @pre depth > 0
+    */
+   ArrayDataRows(
+      const hier::Box& box,
+      unsigned int depth);
+
+   ~ArrayDataRows();
+
+   /**
+    * Add an array.  Arrays are numbered in the order they are added.
+    *
+    * @param array_box Box of the array.
+    * @param depth_offset Distance between depth components of the
+    *                     array, or zero to use its first component for
+    *                     all depths.
+    *
+    * @pre getNumberOfArrays() < MAX_ARRAYS
+    * @pre array_box.contains(box)
+    */
+   void
+   addArray(
+      const hier::Box& array_box,
+      size_t depth_offset);
+
+   /**
+    * Return the number of arrays added.
+    */
+   int
+   getNumberOfArrays() const
+   {
+      return d_num_arrays;
+   }
+
+   /**
+    * Return the number of rows over all depth components.  Zero if the
+    * box is empty.
+    */
+   size_t
+   getNumberOfRows() const
+   {
+      return d_num_rows;
+   }
+
+   /**
+    * Return the number of cells in a row.
+    */
+   size_t
+   getRowLength() const
+   {
+      return d_row_length;
+   }
+
+   /**
+    * Apply a row operation to every row, in parallel when possible.
+    */
+   template<class ROW_OP>
+   void
+   forEachRow(
+      const ROW_OP& op) const
+   {
+      const long num_chunks = static_cast<long>(d_num_chunks);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) if (num_chunks > 1)
+#endif
+      for (long c = 0; c < num_chunks; ++c) {
+         applyChunk(op, static_cast<size_t>(c));
+      }
+   }
+
+   /**
+    * Apply a row operation to every row, one row at a time in order.
+    * For operations with side effects that depend on order, such as
+    * drawing random numbers.
+    */
+   template<class ROW_OP>
+   void
+   forEachRowInOrder(
+      const ROW_OP& op) const
+   {
+      for (size_t c = 0; c < d_num_chunks; ++c) {
+         applyChunk(op, c);
+      }
+   }
+
+   /**
+    * Apply a reducing row operation to every row and return the
+    * combined result, or op.identity() if there are no rows.
+    */
+   template<class ROW_OP>
+   typename ROW_OP::result_type
+   reduceRows(
+      const ROW_OP& op) const
+   {
+      if (d_num_chunks == 1) {
+         return reduceChunk(op, 0);
+      }
+      std::vector<typename ROW_OP::result_type> partial(d_num_chunks,
+                                                        op.identity());
+      const long num_chunks = static_cast<long>(d_num_chunks);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) if (num_chunks > 1)
+#endif
+      for (long c = 0; c < num_chunks; ++c) {
+         partial[static_cast<size_t>(c)] =
+            reduceChunk(op, static_cast<size_t>(c));
+      }
+      typename ROW_OP::result_type result = op.identity();
+      for (size_t c = 0; c < d_num_chunks; ++c) {
+         result = op.combine(result, partial[c]);
+      }
+      return result;
+   }
+
+private:
+   ArrayDataRows(
+      const ArrayDataRows&);            // not implemented
+   ArrayDataRows&
+   operator = (
+      const ArrayDataRows&);            // not implemented
+
+   /*
+    * Apply a row operation to the rows of one chunk.
+    */
+   template<class ROW_OP>
+   void
+   applyChunk(
+      const ROW_OP& op,
+      size_t chunk) const
+   {
+      size_t offsets[MAX_ARRAYS];
+      size_t index[SAMRAI::MAX_DIM_VAL];
+      const size_t end = getChunkEnd(chunk);
+      for (size_t row = getChunkBegin(chunk, offsets, index);
+           row < end; ++row) {
+         op(offsets, d_row_length);
+         advance(row + 1, offsets, index);
+      }
+   }
+
+   /*
+    * Combined result of the rows of one chunk.
+    */
+   template<class ROW_OP>
+   typename ROW_OP::result_type
+   reduceChunk(
+      const ROW_OP& op,
+      size_t chunk) const
+   {
+      typename ROW_OP::result_type result = op.identity();
+      if (d_num_rows > 0) {
+         size_t offsets[MAX_ARRAYS];
+         size_t index[SAMRAI::MAX_DIM_VAL];
+         const size_t end = getChunkEnd(chunk);
+         for (size_t row = getChunkBegin(chunk, offsets, index);
+              row < end; ++row) {
+            result = op.combine(result, op(offsets, d_row_length));
+            advance(row + 1, offsets, index);
+         }
+      }
+      return result;
+   }
+
+   /*
+    * Return the first row of a chunk and set the offsets and the index
+    * in directions 1 and up of that row.
+    */
+   size_t
+   getChunkBegin(
+      size_t chunk,
+      size_t* offsets,
+      size_t* index) const;
+
+   size_t
+   getChunkEnd(
+      size_t chunk) const
+   {
+      const size_t end = (chunk + 1) * d_rows_per_chunk;
+      return end < d_num_rows ? end : d_num_rows;
+   }
+
+   /*
+    * Set the offsets and index of a row from scratch.
+    */
+   void
+   setRow(
+      size_t row,
+      size_t* offsets,
+      size_t* index) const;
+
+   /*
+    * Step the offsets and index from row - 1 to row.  Stepping through
+    * the rows of a depth component only adds strides; moving to the
+    * next depth component starts from scratch.
+    */
+   void
+   advance(
+      size_t row,
+      size_t* offsets,
+      size_t* index) const
+   {
+      for (tbox::Dimension::dir_t k = 1; k < d_dim; ++k) {
+         ++index[k];
+         if (index[k] < d_box_w[k]) {
+            for (int a = 0; a < d_num_arrays; ++a) {
+               offsets[a] += d_stride[a][k];
+            }
+            return;
+         }
+         index[k] = 0;
+         for (int a = 0; a < d_num_arrays; ++a) {
+            offsets[a] -= (d_box_w[k] - 1) * d_stride[a][k];
+         }
+      }
+      if (row < d_num_rows) {
+         setRow(row, offsets, index);
+      }
+   }
+
+   /*
+    * Target number of cells in a chunk.
+    */
+   static const size_t s_chunk_cells;
+
+   const hier::Box d_box;
+   const tbox::Dimension::dir_t d_dim;
+   const unsigned int d_depth;
+
+   size_t d_box_w[SAMRAI::MAX_DIM_VAL];
+   size_t d_row_length;
+   size_t d_rows_per_depth;
+   size_t d_num_rows;
+   size_t d_rows_per_chunk;
+   size_t d_num_chunks;
+
+   int d_num_arrays;
+   size_t d_begin[MAX_ARRAYS];
+   size_t d_depth_offset[MAX_ARRAYS];
+   size_t d_stride[MAX_ARRAYS][SAMRAI::MAX_DIM_VAL];
+};
+
+}
+}
+
+#endif
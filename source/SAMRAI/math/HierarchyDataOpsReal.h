@@ -282,11 +282,14 @@ public:
     * Note that if the control volumes are set properly, this is equivalent to
     * integrating a data component containing all ones over the collection of
     * hierarchy levels.
+    * If local_only is true, the global reduction is not
+    * performed (thus each process will get only local results).
     */
    virtual double
    sumControlVolumes(
       const int data_id,
-      const int vol_id) const = 0;
+      const int vol_id,
+      bool local_only = false) const = 0;
 
    /**
     * Return discrete \f$L_1\f$-norm of the data using the control volume to
@@ -325,12 +328,15 @@ public:
     * (data_i * weight_i)^2 cvol_i ) }\f$.  If the control volume is not defined
     * (vol_id < 0), the return value is
     * \f$\sqrt{ \sum_i ( (data_i * weight_i)^2 ) }\f$.
+    * If local_only is true, the global reduction is not
+    * performed (thus each process will get only local results).
     */
    virtual double
    weightedL2Norm(
       const int data_id,
       const int weight_id,
-      const int vol_id = -1) const = 0;
+      const int vol_id = -1,
+      bool local_only = false) const = 0;
 
    /**
     * Return discrete root mean squared norm of the data.  If the control
@@ -387,6 +387,8 @@ public:
     * Return sum of the control volumes associated with the data component.
     * Note that if the control volumes are set properly, this is equivalent to
     * integrating a data component containing all ones over the collection of
+    * If local_only is true, the global reduction is not
+    * performed (thus each process will get only local results).
     *
     * @pre vol_id >= 0
     * @pre getPatchHierarchy()
@@ -397,7 +399,8 @@ public:
    double
    sumControlVolumes(
       const int data_id,
-      const int vol_id) const;
+      const int vol_id,
+      bool local_only = false) const;
 
    /**
     * Return discrete \f$L_1\f$-norm of the data using the control volume to
@@ -440,6 +443,8 @@ public:
     * (data_i * weight_i)^2 cvol_i ) }\f$.  If the control volume is not defined
     * (vol_id < 0), the return value is
     * \f$\sqrt{ \sum_i ( (data_i * weight_i)^2 ) }\f$.
+    * If local_only is true, the global reduction is not
+    * performed (thus each process will get only local results).
     *
     * @pre getPatchHierarchy()
     * @pre (d_coarsest_level >= 0) && (d_finest_level >= d_coarsest_level) &&
@@ -449,7 +454,8 @@ public:
    weightedL2Norm(
       const int data_id,
       const int weight_id,
-      const int vol_id = -1) const;
+      const int vol_id = -1,
+      bool local_only = false) const;
 
    /**
     * Return discrete root mean squared norm of the data.  If the control
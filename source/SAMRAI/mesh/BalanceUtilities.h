@@ -16,6 +16,7 @@
 #include "SAMRAI/hier/BaseGridGeometry.h"
 #include "SAMRAI/hier/Connector.h"
 #include "SAMRAI/hier/MappingConnector.h"
+#include "SAMRAI/hier/PatchHierarchy.h"
 #include "SAMRAI/hier/PatchLevel.h"
 #include "SAMRAI/hier/ProcessorMapping.h"
 #include "SAMRAI/math/PatchCellDataNormOpsReal.h"
@@ -25,6 +26,7 @@
 
 #include <iostream>
 #include <list>
+#include <memory>
 #include <vector>
 
 namespace SAMRAI {
@@ -488,7 +490,135 @@ struct BalanceUtilities {
       hier::Connector* balance_to_anchor,
       const tbox::RankGroup& rank_group);
 
+   //@{
+
+   //! @name Migration-aware load balancing.
+
+   static const int BalanceUtilities_PREVIOUSOWNER0 = 7;
+   static const int BalanceUtilities_PREVIOUSOWNER1 = 8;
+
+   /*!
+    * @brief Connect a BoxLevel being balanced to the version of the
+    * same level currently in the hierarchy.
+    *
+    * The previous version is available when the hierarchy has a
+    * level at level_number with the same refinement ratio as
+    * balance_box_level and the head of balance_to_reference is the
+    * hierarchy's next coarser level.  This is the case when
+    * GriddingAlgorithm regrids an existing finer level.  The bridge
+    * is done through the coarser level and the resulting Connector
+    * has zero width.
+    *
+    * All processes must call this method.
+    *
+    * @param[out] balance_to_previous Connector from the BoxLevel
+    * being balanced to the previous level, with its transpose.
+    * Unchanged if the previous level is not available.
+    *
+    * @param[in] balance_to_reference
+    *
+    * @param[in] hierarchy
+    *
+    * @param[in] level_number Level number of the BoxLevel being
+    * balanced.
+    *
+    * @return Whether the previous level was available.
+    *
+    * @pre balance_to_reference.hasTranspose()
+    */
+   static bool
+   bridgeToPreviousLevel(
+      std::shared_ptr<hier::Connector>& balance_to_previous,
+      const hier::Connector& balance_to_reference,
+      const hier::PatchHierarchy& hierarchy,
+      int level_number);
+
+   /*!
+    * @brief Move each Box of balance_box_level to the process owning
+    * the previous-level Box that contains its center cell.
+    *
+    * This gives load balancers starting from the current
+    * distribution a hint that keeps new Boxes where most of their
+    * data already lives.  Boxes whose centers are not on the previous
+    * level stay where they are.  The decision is made independently
+    * by the current owner (from balance_to_previous) and by the
+    * previous owner (from its transpose), so only the new LocalIds
+    * are communicated.
+    *
+    * Modify the given connectors to make them correct following this
+    * moving of boxes.
+    *
+    * @param[in,out] balance_box_level
+    *
+    * @param[in,out] balance_to_anchor
+    *
+    * @param[in] balance_to_previous Zero-width Connector from
+    * balance_box_level to the previous level, as computed by
+    * bridgeToPreviousLevel.  It is not valid after this call.
+    *
+    * @pre balance_to_previous.hasTranspose()
+    * @pre !balance_to_anchor || balance_to_anchor->hasTranspose()
+    */
+   static void
+   assignToPreviousOwners(
+      hier::BoxLevel& balance_box_level,
+      hier::Connector* balance_to_anchor,
+      const hier::Connector& balance_to_previous);
+
+   /*!
+    * @brief Compute the number of bytes of patch data the local
+    * process must send to other processes to move data from the
+    * previous level to a new level.
+    *
+    * The patch data components counted are the ones allocated on the
+    * local patches of the previous level.
+    *
+    * @param[in] previous_to_balance Zero-width Connector from the
+    * previous level to the new level, such as the transpose of the
+    * Connector computed by bridgeToPreviousLevel.
+    *
+    * @param[in] previous_level
+    */
+   static double
+   computeMigratedBytes(
+      const hier::Connector& previous_to_balance,
+      const hier::PatchLevel& previous_level);
+
+   /*!
+    * @brief Record the bytes the local process sends to move patch
+    * data from the previous version of a level to a newly balanced
+    * BoxLevel.
+    *
+    * The value is recorded in the PROC_STAT Statistic
+    * "LB_MigratedBytesL<level_number>" when the previous level is
+    * available (see bridgeToPreviousLevel), and nothing is recorded
+    * otherwise.  All processes must call this method.
+    *
+    * @param[in] balance_to_reference
+    *
+    * @param[in] hierarchy
+    *
+    * @param[in] level_number
+    *
+    * @pre balance_to_reference.hasTranspose()
+    */
+   static void
+   recordMigratedBytes(
+      const hier::Connector& balance_to_reference,
+      const hier::PatchHierarchy& hierarchy,
+      int level_number);
+
+   //@}
+
 private:
+   /*
+    * Center cell of a Box, used to decide which previous Box a new
+    * Box belongs to.
+    */
+   static hier::Index
+   privateCenterCell(
+      const hier::Box& box);
+
    struct RankAndLoad {
       int rank;
       double load;
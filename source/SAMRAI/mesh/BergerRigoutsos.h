@@ -58,6 +58,13 @@ class BergerRigoutsosNode;
  *       Whether to sort the output. This makes the normally non-deterministic
  *       ordering deterministic and the results repeatable.
  *
+ *    - \b concurrent_sibling_histograms
+ *       Whether to compute the local tag histograms of the nodes waiting
+ *       to be launched concurrently, one node per thread, instead of
+ *       threading the histogram of each node.  This helps deep in the
+ *       clustering tree, where nodes are small and numerous.  It has no
+ *       effect without OpenMP and does not change the results.
+ *
  *    - \b check_min_box_size
  *       A flag to control how to resolve an initial box that violates the
  *       minimum box size. Set to one of these strings: <br>
@@ -118,6 +125,14 @@ class BergerRigoutsosNode;
  *     <td>Not written to restart. Value in input db used.</td>
  *   </tr>
  *   <tr>
+ *     <td>concurrent_sibling_histograms</td>
+ *     <td>bool</td>
+ *     <td>FALSE</td>
+ *     <td>TRUE, FALSE</td>
+ *     <td>opt</td>
+ *     <td>Not written to restart. Value in input db used.</td>
+ *   </tr>
+ *   <tr>
  *     <td>check_min_box_size</td>
  *     <td>string</td>
  *     <td>"WARN"</td>
@@ -515,6 +530,13 @@ private:
    void
    shareNewNeighborhoodSetsWithOwners();
 
+   /*!
+    * @brief Compute the local tag histograms of all nodes in the
+    * relaunch queue that need them, one node per thread.
+    */
+   void
+   computeQueuedHistograms();
+
    const tbox::Dimension& getDim() const {
       return d_tag_level->getDim();
    }
@@ -689,6 +711,12 @@ private:
    //! @brief Whether to sort results to make them deterministic.
    bool d_sort_output_nodes;
 
+   /*!
+    * @brief Whether to compute the histograms of queued nodes
+    * concurrently.
+    */
+   bool d_concurrent_sibling_histograms;
+
    /*!
     * @brief Whether to build tag<==>new Connectors width of zero,
     * disregarding the width specified in findBoxesContainingTags().
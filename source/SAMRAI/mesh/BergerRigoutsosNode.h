@@ -236,6 +236,28 @@ private:
    void
    makeLocalTagHistogram();
 
+   void
+   computeLocalTagHistogram();
+
+   /*!
+    * @brief Whether the next continueAlgorithm() call computes the
+    * local tag histogram.
+    */
+   bool
+   needsLocalTagHistogram() const;
+
+   /*!
+    * @brief Compute the local tag histogram ahead of the next
+    * continueAlgorithm() call.
+    *
+    * This only touches data of this node, so BergerRigoutsos may call
+    * it concurrently for different nodes.
+    *
+    * @pre needsLocalTagHistogram()
+    */
+   void
+   precomputeLocalTagHistogram();
+
    void
    reduceHistogram_start();
 
@@ -558,6 +580,12 @@ private:
     */
    VectorOfInts d_histogram[SAMRAI::MAX_DIM_VAL];
 
+   /*!
+    * @brief Whether d_histogram holds the local histogram computed by
+    * precomputeLocalTagHistogram().
+    */
+   bool d_histogram_ready;
+
    /*!
     * @brief Number of tags in the candidate box.
     */
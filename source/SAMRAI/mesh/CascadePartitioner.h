@@ -79,6 +79,21 @@ namespace mesh {
  *   load balancing always uses the voucher method regardless of this
  *   parameter's value.
  *
+ *   - \b minimize_migration
+ *   Boolean parameter to use the previous version of a level being
+ *   regridded as a hint.  New boxes first go to the owners of the old
+ *   data under their centers, and processes keep load up to half of
+ *   flexible_load_tolerance above the average, so only the excess is
+ *   moved.  The other half is left for the slack in shipments.  This reduces data movement after regridding at the cost
+ *   of more imbalance.  It has no effect when the level is new or
+ *   when the reference level is not the next coarser hierarchy level.
+ *
+ *   - \b record_migration
+ *   Boolean parameter to record the bytes of patch data each process
+ *   sends to move data from the previous version of a level to the
+ *   balanced level in the Statistic "LB_MigratedBytesL<ln>".  Always
+ *   recorded when minimize_migration is TRUE.
+ *
  * <b> Details: </b> <br>
  * <table>
  *   <tr>
@@ -121,6 +136,22 @@ namespace mesh {
  *     <td>opt</td>
  *     <td>Not written to restart. Value in input db used.</td>
  *   </tr>
+ *   <tr>
+ *     <td>minimize_migration</td>
+ *     <td>bool</td>
+ *     <td>FALSE</td>
+ *     <td>TRUE or FALSE</td>
+ *     <td>opt</td>
+ *     <td>Not written to restart. Value in input db used.</td>
+ *   </tr>
+ *   <tr>
+ *     <td>record_migration</td>
+ *     <td>bool</td>
+ *     <td>FALSE</td>
+ *     <td>TRUE or FALSE</td>
+ *     <td>opt</td>
+ *     <td>Not written to restart. Value in input db used.</td>
+ *   </tr>
  * </table>
  *
  * @internal The following are developer inputs.  Defaults listed
@@ -453,6 +484,22 @@ private:
     */
    bool d_use_vouchers;
 
+   /*!
+    * @brief Whether to start from the owners of the previous level
+    * and move only load in excess of the tolerance.
+    *
+    * See input parameter "minimize_migration".
+    */
+   bool d_minimize_migration;
+
+   /*!
+    * @brief Whether to record the bytes migrated from the previous
+    * level.
+    *
+    * See input parameter "record_migration".
+    */
+   bool d_record_migration;
+
    /*!
     * @brief Metadata operations with timers set according to this object.
     */
@@ -470,6 +517,8 @@ private:
    mutable std::shared_ptr<PartitioningParams> d_pparams;
    mutable LoadType d_global_work_sum;
    mutable LoadType d_global_work_avg;
+   //! @brief Ratio of the load a group is obliged to take to its average.
+   mutable LoadType d_obligation_factor;
    mutable LoadType d_local_work_max;
    mutable LoadType d_min_load;
    mutable size_t d_num_initial_owners;
@@ -508,6 +557,7 @@ private:
     */
    std::shared_ptr<tbox::Timer> t_load_balance_box_level;
    std::shared_ptr<tbox::Timer> t_assign_to_local_and_populate_maps;
+   std::shared_ptr<tbox::Timer> t_assign_to_previous_owners;
    std::shared_ptr<tbox::Timer> t_use_map;
    std::shared_ptr<tbox::Timer> t_communication_wait;
    std::shared_ptr<tbox::Timer> t_distribute_load;
@@ -0,0 +1,538 @@
+/*************************************************************************
+ *
+ * This file is part of the SAMRAI distribution.  For full copyright
+ * information, see COPYRIGHT and LICENSE.
+ *
+ * Copyright:     (c) 1997-2017 Lawrence Livermore National Security, LLC
+ * Description:   Scalable load balancer using a Hilbert space-filling curve.
+ *
+ ************************************************************************/
+
+#ifndef included_mesh_HilbertLoadBalancer
+#define included_mesh_HilbertLoadBalancer
+
+#include "SAMRAI/SAMRAI_config.h"
+#include "SAMRAI/hier/MappingConnectorAlgorithm.h"
+#include "SAMRAI/mesh/BoxInTransit.h"
+#include "SAMRAI/mesh/LoadBalanceStrategy.h"
+#include "SAMRAI/mesh/PartitioningParams.h"
+#include "SAMRAI/tbox/Database.h"
+#include "SAMRAI/tbox/SAMRAI_MPI.h"
+#include "SAMRAI/tbox/RankGroup.h"
+#include "SAMRAI/tbox/Timer.h"
+#include "SAMRAI/tbox/Utilities.h"
+
+#include <cmath>
+#include <iostream>
+#include <map>
+#include <vector>
+#include <memory>
+
+namespace SAMRAI {
+namespace mesh {
+
+/*!
+ * @brief Provides load balancing routines for AMR hierarchy by
+ * implementing the LoadBalanceStrategy with a Hilbert space-filling
+ * curve.
+ *
+ * Each Box is placed on a Hilbert curve by the position of its center
+ * in the coordinates of its block's level-zero domain.  Because the
+ * position does not depend on the refinement ratio, Boxes covering the
+ * same region on different levels land at the same place on the curve
+ * and tend to go to the same processes.  The curve visits blocks in
+ * order of their BlockId.  The curve is cut into pieces of equal load,
+ * one piece per process in the RankGroup, and each process receives
+ * the Boxes in its piece.  A Box that straddles a cut is broken at the
+ * cut, subject to the constraints in PartitioningParams (minimum size,
+ * cut factor and bad interval).
+ *
+ * Boxes are ordered on the curve by block, then by the full Hilbert
+ * key of their centers, then by BoxId.  Their global positions come
+ * from a parallel sample sort of the keys alone: each process sorts
+ * its own Boxes, regularly spaced samples of all the sorted lists
+ * choose splitters that give each process a contiguous range of the
+ * curve, and each process sorts the keys in its range and places them
+ * with a prefix sum of one value per process.  The positions go back
+ * to the owners of the Boxes, and the Boxes go directly from their
+ * current owners to their new owners in a single round of
+ * point-to-point messages.
+ *
+ * This class currently supports only uniform load balancing, treating
+ * all cells of a level as having equal load value.
+ *
+ * <b> Input Parameters </b>
+ *
+ * <b> Definitions: </b>
+ *
+ *   - \b flexible_load_tolerance
+ *   Fraction of ideal load a process can take on in order to avoid
+ *   breaking a Box at a cut on the curve.  Higher values often reduce
+ *   box count but produce less balanced work loads.
+ *
+ *   - \b tile_size
+ *   Tile size when using tile mode.  Tile mode restricts box cuts
+ *   to tile boundaries.  Default is 1, which is equivalent to no restriction.
+ *
+ *   - \b report_load_balance
+ *   Whether to report the load balance in the log after each call to
+ *   loadBalanceBoxLevel().
+ *
+ * <b> Details: </b> <br>
+ * <table>
+ *   <tr>
+ *     <th>parameter</th>
+ *     <th>type</th>
+ *     <th>default</th>
+ *     <th>range</th>
+ *     <th>opt/req</th>
+ *     <th>behavior on restart</th>
+ *   </tr>
+ *   <tr>
+ *     <td>flexible_load_tolerance</td>
+ *     <td>double</td>
+ *     <td>0.05</td>
+ *     <td>0-1</td>
+ *     <td>opt</td>
+ *     <td>Not written to restart. Value in input db used.</td>
+ *   </tr>
+ *   <tr>
+ *     <td>tile_size</td>
+ *     <td>IntVector</td>
+ *     <td>1</td>
+ *     <td>1-</td>
+ *     <td>opt</td>
+ *     <td>Not written to restart. Value in input db used.</td>
+ *   </tr>
+ *   <tr>
+ *     <td>report_load_balance</td>
+ *     <td>bool</td>
+ *     <td>FALSE</td>
+ *     <td>TRUE or FALSE</td>
+ *     <td>opt</td>
+ *     <td>Not written to restart. Value in input db used.</td>
+ *   </tr>
+ * </table>
+ *
+ * @internal The following are developer inputs.  Defaults listed
+ * in parenthesis:
+ *
+ * @internal DEV_print_steps (FALSE)
+ * bool
+ * Whether to log the partitioning steps.
+ *
+ * @internal DEV_check_map (FALSE)
+ * bool
+ * Whether to check the unbalanced<==>balanced mapping for errors.
+ *
+ * @see LoadBalanceStrategy
+ */
+
+class HilbertLoadBalancer:
+   public LoadBalanceStrategy
+{
+public:
+   /*!
+    * @brief Initializing constructor sets object state to default or,
+    * if database provided, to parameters in database.
+    *
+    * @param[in] dim
+    *
+    * @param[in] name User-defined identifier used for error reporting
+    * and timer names.
+    *
+    * @param[in] input_db (optional) database pointer providing
+    * parameters from input file.  This pointer may be null indicating
+    * no input is used.
+    *
+    * @pre !name.empty()
+    */
+   HilbertLoadBalancer(
+      const tbox::Dimension& dim,
+      const std::string& name,
+      const std::shared_ptr<tbox::Database>& input_db =
+         std::shared_ptr<tbox::Database>());
+
+   /*!
+    * @brief Virtual destructor releases all internal storage.
+    */
+   virtual ~HilbertLoadBalancer();
+
+   /*!
+    * @copydoc LoadBalanceStrategy::loadBalanceBoxLevel()
+    *
+    * Note: This implementation does not yet support non-uniform load
+    * balancing.
+    *
+    * @pre !balance_to_anchor || balance_to_anchor->hasTranspose()
+    * @pre !balance_to_anchor || balance_to_anchor->isTransposeOf(balance_to_anchor->getTranspose())
+    * @pre (d_dim == balance_box_level.getDim()) &&
+    *      (d_dim == min_size.getDim()) && (d_dim == max_size.getDim()) &&
+    *      (d_dim == domain_box_level.getDim()) &&
+    *      (d_dim == bad_interval.getDim()) && (d_dim == cut_factor.getDim())
+    * @pre !hierarchy || (d_dim == hierarchy->getDim())
+    */
+   void
+   loadBalanceBoxLevel(
+      hier::BoxLevel& balance_box_level,
+      hier::Connector* balance_to_anchor,
+      const std::shared_ptr<hier::PatchHierarchy>& hierarchy,
+      const int level_number,
+      const hier::IntVector& min_size,
+      const hier::IntVector& max_size,
+      const hier::BoxLevel& domain_box_level,
+      const hier::IntVector& bad_interval,
+      const hier::IntVector& cut_factor,
+      const tbox::RankGroup& rank_group = tbox::RankGroup()) const;
+
+   /*!
+    * @brief Configure the load balancer to use the data stored
+    * in the hierarchy at the specified descriptor index
+    * for estimating the workload on each cell.
+    *
+    * Note: This method currently does not affect the results because
+    * this class does not yet support non-uniform load balancing.
+    *
+    * @param data_id
+    * Integer value of patch data identifier for workload
+    * estimate on each cell.
+    *
+    * @param level_number
+    * Optional integer number for level on which data id
+    * is used.
+    */
+   void
+   setWorkloadPatchDataIndex(
+      int data_id,
+      int level_number = -1)
+   {
+      NULL_USE(data_id);
+      NULL_USE(level_number);
+   }
+
+   /*!
+    * @brief Return true if load balancing procedure for given level
+    * depends on patch data on mesh; otherwise return false.
+    *
+    * @param[in] level_number  Integer patch level number.
+    */
+   bool
+   getLoadBalanceDependsOnPatchData(
+      int level_number) const
+   {
+      NULL_USE(level_number);
+      return false;
+   }
+
+   /*!
+    * @brief Write out statistics recorded for the most recent load
+    * balancing result.
+    *
+    * @param[in] output_stream
+    */
+   void
+   printStatistics(
+      std::ostream& output_stream = tbox::plog) const;
+
+   /*!
+    * @brief Get the name of this object.
+    */
+   const std::string&
+   getObjectName() const
+   {
+      return d_object_name;
+   }
+
+   /*!
+    * @brief Compute the Hilbert index of a point.
+    *
+    * The index has num_bits*dim significant bits.  Points adjacent on
+    * the curve are adjacent in space.
+    *
+    * @param[in] coords Coordinates of the point, each in [0, 2^num_bits).
+    *
+    * @param[in] dim
+    *
+    * @param[in] num_bits Number of bits per coordinate.
+    *
+    * @pre num_bits*dim.getValue() <= 64
+    */
+   static unsigned long long
+   computeHilbertIndex(
+      const unsigned long long* coords,
+      const tbox::Dimension& dim,
+      int num_bits);
+
+private:
+   typedef double LoadType;
+
+   /*
+    * Tag for messages carrying Boxes to their new owners.
+    */
+   static const int HilbertLoadBalancer_BOXTAG = 1;
+
+   /*
+    * Upper limits on the number of samples each process contributes to
+    * the choice of splitters, and on the number of samples over all
+    * processes.
+    */
+   static const int MAX_SAMPLES_PER_PROCESS = 16;
+   static const int MAX_SAMPLES = 1 << 16;
+
+   /*!
+    * @brief The place of a Box on the curve, as sent between processes
+    * by the sample sort.
+    *
+    * Keys are ordered by block, then Hilbert key, then the GlobalId of
+    * the Box.  A negative load marks an empty sample.
+    */
+   struct CurveKey {
+      unsigned long long d_key;
+      LoadType d_load;
+      int d_block;
+      int d_owner;
+      int d_local_id;
+      bool
+      operator < (
+         const CurveKey& other) const
+      {
+         if (d_block != other.d_block) {
+            return d_block < other.d_block;
+         }
+         if (d_key != other.d_key) {
+            return d_key < other.d_key;
+         }
+         if (d_owner != other.d_owner) {
+            return d_owner < other.d_owner;
+         }
+         return d_local_id < other.d_local_id;
+      }
+   };
+
+   /*!
+    * @brief Orders indices into a vector of CurveKeys by their keys.
+    */
+   struct KeyIndexLess {
+      explicit KeyIndexLess(
+         const std::vector<CurveKey>& keys):
+         d_keys(keys) {
+      }
+      bool
+      operator () (
+         size_t a,
+         size_t b) const
+      {
+         return d_keys[a] < d_keys[b];
+      }
+      const std::vector<CurveKey>& d_keys;
+   };
+
+   /*!
+    * @brief A local Box with its place on the curve.
+    */
+   struct CurveBox {
+      explicit CurveBox(
+         const hier::Box& box):
+         d_box(box)
+      {
+         d_curve_key.d_key = 0;
+         d_curve_key.d_load = static_cast<LoadType>(box.size());
+         d_curve_key.d_block =
+            static_cast<int>(box.getBlockId().getBlockValue());
+         d_curve_key.d_owner = box.getOwnerRank();
+         d_curve_key.d_local_id = box.getLocalId().getValue();
+      }
+      CurveKey d_curve_key;
+      hier::Box d_box;
+      bool
+      operator < (
+         const CurveBox& other) const
+      {
+         return d_curve_key < other.d_curve_key;
+      }
+   };
+
+   /*!
+    * @brief Boxes and cut positions bound for one process.
+    */
+   struct Shipment {
+      Shipment():
+         d_lower(-1.0),
+         d_upper(-1.0) {
+      }
+      LoadType d_lower;
+      LoadType d_upper;
+      std::vector<BoxInTransit> d_boxes;
+   };
+
+   // The following are not implemented, but are provided here for
+   // dumb compilers.
+   HilbertLoadBalancer(
+      const HilbertLoadBalancer&);
+   void
+   operator = (
+      const HilbertLoadBalancer&);
+
+   /*!
+    * @brief Sort the local Boxes along the curve.
+    */
+   void
+   sortBoxesAlongCurve(
+      std::vector<CurveBox>& curve_boxes,
+      const hier::BoxLevel& balance_box_level) const;
+
+   /*!
+    * @brief Compute the global curve position of each local Box.
+    *
+    * @param[out] positions Start of each Box on the curve.
+    *
+    * @param[out] global_load Total load on the curve.
+    *
+    * @param[in] curve_boxes Local Boxes sorted along the curve.
+    *
+    * @param[in] mpi
+    */
+   void
+   computeCurvePositions(
+      std::vector<LoadType>& positions,
+      LoadType& global_load,
+      const std::vector<CurveBox>& curve_boxes,
+      const tbox::SAMRAI_MPI& mpi) const;
+
+   /*!
+    * @brief Choose the splitters dividing the curve into one range of
+    * keys per process.
+    *
+    * Keys less than splitters[0] go to process 0, and keys not less
+    * than splitters[p-1] and less than splitters[p] go to process p.
+    *
+    * @param[out] splitters mpi.getSize()-1 keys in order.
+    *
+    * @param[in] curve_boxes Local Boxes sorted along the curve.
+    *
+    * @param[in] mpi
+    */
+   void
+   chooseSplitters(
+      std::vector<CurveKey>& splitters,
+      const std::vector<CurveBox>& curve_boxes,
+      const tbox::SAMRAI_MPI& mpi) const;
+
+   /*!
+    * @brief Cut the curve and sort local Boxes (or pieces of them)
+    * into shipments by their new owners.
+    *
+    * The process owning the Box at each cut decides where the cut
+    * really falls and tells the processes on both sides of it.
+    */
+   void
+   cutCurve(
+      std::map<int, Shipment>& shipments,
+      const std::vector<CurveBox>& curve_boxes,
+      const std::vector<LoadType>& positions,
+      LoadType global_load,
+      const tbox::RankGroup& rank_group,
+      const PartitioningParams& pparams) const;
+
+   /*!
+    * @brief Send shipments to their new owners and receive the Boxes
+    * assigned to the local process.
+    *
+    * A process knows it has received everything once it has heard
+    * from the owners of both of its cuts and has received the load
+    * between them.
+    */
+   void
+   exchangeShipments(
+      std::vector<BoxInTransit>& received,
+      std::map<int, Shipment>& shipments,
+      LoadType global_load,
+      const tbox::RankGroup& rank_group,
+      const tbox::SAMRAI_MPI& mpi) const;
+
+   /*!
+    * @brief Position of a cut on the curve.
+    *
+    * Cut i separates the load of rank group member i-1 from member i.
+    */
+   LoadType
+   cutPosition(
+      int cut_number,
+      LoadType global_load,
+      int group_size) const
+   {
+      return std::floor(global_load * cut_number / group_size);
+   }
+
+   /*
+    * Read parameters from input database.
+    */
+   void
+   getFromInput(
+      const std::shared_ptr<tbox::Database>& input_db);
+
+   /*!
+    * @brief Set up timers for the object.
+    */
+   void
+   setTimers();
+
+   /*
+    * Object dimension.
+    */
+   const tbox::Dimension d_dim;
+
+   /*
+    * String identifier for load balancer object.
+    */
+   std::string d_object_name;
+
+   /*!
+    * @brief Tile size, when restricting cuts to tile boundaries,
+    * Set to 1 when not restricting.
+    */
+   hier::IntVector d_tile_size;
+
+   /*!
+    * @brief Fraction of ideal load a process can accept over and above
+    * the ideal.
+    *
+    * See input parameter "flexible_load_tolerance".
+    */
+   double d_flexible_load_tol;
+
+   /*!
+    * @brief Metadata operations with timers set according to this object.
+    */
+   hier::MappingConnectorAlgorithm d_mca;
+
+   /*!
+    * @brief Whether to immediately report the results of the load
+    * balancing cycles in the log files.
+    */
+   bool d_report_load_balance;
+
+   /*
+    * Performance timers.
+    */
+   std::shared_ptr<tbox::Timer> t_load_balance_box_level;
+   std::shared_ptr<tbox::Timer> t_sort_boxes_along_curve;
+   std::shared_ptr<tbox::Timer> t_compute_curve_positions;
+   std::shared_ptr<tbox::Timer> t_cut_curve;
+   std::shared_ptr<tbox::Timer> t_exchange_shipments;
+   std::shared_ptr<tbox::Timer> t_assign_to_local_and_populate_maps;
+   std::shared_ptr<tbox::Timer> t_use_map;
+
+   // Extra checks independent of optimization/debug.
+   bool d_print_steps;
+   bool d_check_map;
+
+   mutable std::vector<double> d_load_stat;
+   mutable std::vector<int> d_box_count_stat;
+
+};
+
+}
+}
+
+#endif
@@ -0,0 +1,169 @@
+/*************************************************************************
+ *
+ * This file is part of the SAMRAI distribution.  For full copyright
+ * information, see COPYRIGHT and LICENSE.
+ *
+ * Copyright:     (c) 1997-2017 Lawrence Livermore National Security, LLC
+ * Description:   Workload data built from measured patch compute times.
+ *
+ ************************************************************************/
+
+#ifndef included_mesh_MeasuredWorkload
+#define included_mesh_MeasuredWorkload
+
+#include "SAMRAI/SAMRAI_config.h"
+
+#include "SAMRAI/hier/PatchLevel.h"
+#include "SAMRAI/mesh/LoadBalanceStrategy.h"
+#include "SAMRAI/pdat/CellVariable.h"
+#include "SAMRAI/tbox/Dimension.h"
+#include "SAMRAI/xfer/RefineAlgorithm.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace SAMRAI {
+namespace mesh {
+
+/*!
+ * @brief Workload data built from the measured compute time of each
+ * patch, for load balancers that accept a workload patch data index.
+ *
+ * An integrator times the numerical kernels on each local patch of a
+ * level and passes the times to recordLevelCost().  The time per cell
+ * of each patch is divided by the average time per cell on the level,
+ * so a cell of average cost has workload 1, the same as the uniform
+ * (cell count) model.  The result is blended into the workload data
+ * with an exponential moving average,
+ *
+ * @code
+ *    workload = s * measured + (1 - s) * workload
+ * @endcode
+ *
+ * where s is the smoothing factor.  Workload data starts at 1 on new
+ * patches and is carried from the old level to the new one at regrid,
+ * so the load balancer sees the smoothed cost at the next regrid.
+ *
+ * The workload variable is registered with the VariableDatabase and
+ * for restart when this object is constructed.  The integrator must
+ * allocate and fill the data on new levels (see initializeLevelData()
+ * and registerRefine()) and give the data index to the load balancers
+ * (see registerWithLoadBalancer()).
+ *
+ * Only load balancers that use workload data (CascadePartitioner and
+ * ChopAndPackLoadBalancer) are affected.
+ *
+ * @see HyperbolicLevelIntegrator
+ * @see MethodOfLinesIntegrator
+ */
+class MeasuredWorkload
+{
+public:
+   /*!
+    * @brief Construct and register the workload variable.
+    *
+    * @param[in] dim
+    * @param[in] object_name Name of the object, also used to name the
+    * workload variable.
+    * @param[in] smoothing_factor Weight of the newest measurement, in
+    * (0,1].  A value of 1 uses only the latest step.
+    *
+    * @pre !object_name.empty()
+    * @pre smoothing_factor > 0.0 && smoothing_factor <= 1.0
+    */
+   MeasuredWorkload(
+      const tbox::Dimension& dim,
+      const std::string& object_name,
+      double smoothing_factor = 0.5);
+
+   /*!
+    * @brief Destructor.
+    */
+   ~MeasuredWorkload();
+
+   /*!
+    * @brief Return the patch data index of the workload data.
+    */
+   int
+   getWorkloadDataId() const
+   {
+      return d_workload_data_id;
+   }
+
+   /*!
+    * @brief Return the weight of the newest measurement.
+    */
+   double
+   getSmoothingFactor() const
+   {
+      return d_smoothing_factor;
+   }
+
+   /*!
+    * @brief Set the workload data index on a load balancer for all
+    * levels.
+    */
+   void
+   registerWithLoadBalancer(
+      LoadBalanceStrategy& load_balancer) const;
+
+   /*!
+    * @brief Register the workload data with an algorithm filling new
+    * levels, so that measured costs carry over from the old level and
+    * from coarser levels.
+    */
+   void
+   registerRefine(
+      xfer::RefineAlgorithm& fill_new_level) const;
+
+   /*!
+    * @brief Allocate the workload data on the patches of a level that
+    * do not have it and set it to 1 there.
+    *
+    * Call before filling a new level so that cells not filled from
+    * other levels keep the uniform workload.
+    */
+   void
+   initializeLevelData(
+      hier::PatchLevel& level,
+      double time) const;
+
+   /*!
+    * @brief Blend measured patch compute times into the workload data.
+    *
+    * This is a collective operation over the level's communicator.
+    *
+    * @param[in,out] level
+    * @param[in] patch_seconds Compute time of each local patch, in the
+    * order of the level's patch iterator.
+    *
+    * @pre static_cast<int>(patch_seconds.size()) == level.getLocalNumberOfPatches()
+    */
+   void
+   recordLevelCost(
+      hier::PatchLevel& level,
+      const std::vector<double>& patch_seconds) const;
+
+private:
+   // The following are not implemented:
+   MeasuredWorkload(
+      const MeasuredWorkload&);
+
+   MeasuredWorkload&
+   operator = (
+      const MeasuredWorkload&);
+
+   std::string d_object_name;
+
+   std::shared_ptr<pdat::CellVariable<double> > d_workload_variable;
+
+   int d_workload_data_id;
+
+   double d_smoothing_factor;
+};
+
+}
+}
+
+#endif
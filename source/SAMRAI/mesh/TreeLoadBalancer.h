@@ -68,6 +68,21 @@ namespace mesh {
  *   multiple cycles.  It alleviates the bottle-neck of one process having
  *   to work with too many other processes in any cycle.
  *
+ *   - \b minimize_migration
+ *   Boolean parameter to use the previous version of a level being
+ *   regridded as a hint.  New boxes first go to the owners of the old
+ *   data under their centers, and the tree then moves only load above
+ *   flexible_load_tolerance.  This reduces data movement after
+ *   regridding.  It has no effect when the level is new, when the
+ *   reference level is not the next coarser hierarchy level or when
+ *   balancing to a subset of ranks.
+ *
+ *   - \b record_migration
+ *   Boolean parameter to record the bytes of patch data each process
+ *   sends to move data from the previous version of a level to the
+ *   balanced level in the Statistic "LB_MigratedBytesL<ln>".  Always
+ *   recorded when minimize_migration is TRUE.
+ *
  * <b> Details: </b> <br>
  * <table>
  *   <tr>
@@ -102,6 +117,22 @@ namespace mesh {
  *     <td>opt</td>
  *     <td>Not written to restart. Value in input db used.</td>
  *   </tr>
+ *   <tr>
+ *     <td>minimize_migration</td>
+ *     <td>bool</td>
+ *     <td>FALSE</td>
+ *     <td>TRUE or FALSE</td>
+ *     <td>opt</td>
+ *     <td>Not written to restart. Value in input db used.</td>
+ *   </tr>
+ *   <tr>
+ *     <td>record_migration</td>
+ *     <td>bool</td>
+ *     <td>FALSE</td>
+ *     <td>TRUE or FALSE</td>
+ *     <td>opt</td>
+ *     <td>Not written to restart. Value in input db used.</td>
+ *   </tr>
  * </table>
  *
  * @internal The following are developer inputs.  Defaults listed
@@ -749,6 +780,12 @@ private:
    //! @brief Whether to allow box breaking.
    bool d_allow_box_breaking;
 
+   //! @brief Whether to start from the owners of the previous level.
+   bool d_minimize_migration;
+
+   //! @brief Whether to record the bytes migrated from the previous level.
+   bool d_record_migration;
+
    //! @brief How to arange a contiguous range of MPI ranks in a tree.
    const std::shared_ptr<tbox::RankTreeStrategy> d_rank_tree;
 
@@ -823,6 +860,7 @@ private:
    std::shared_ptr<tbox::Timer> t_get_load_from_parent;
    std::shared_ptr<tbox::Timer> t_post_load_distribution_barrier;
    std::shared_ptr<tbox::Timer> t_assign_to_local_and_populate_maps;
+   std::shared_ptr<tbox::Timer> t_assign_to_previous_owners;
    std::shared_ptr<tbox::Timer> t_report_loads;
    std::shared_ptr<tbox::Timer> t_local_load_moves;
    std::shared_ptr<tbox::Timer> t_finish_sends;
@@ -20,9 +20,11 @@
 #include "SAMRAI/hier/IntVector.h"
 #include "SAMRAI/tbox/Complex.h"
 #include "SAMRAI/tbox/Database.h"
+#include "SAMRAI/tbox/MemoryAllocator.h"
 #include "SAMRAI/tbox/MemoryUtilities.h"
 #include "SAMRAI/tbox/MessageStream.h"
 
+#include <memory>
 #include <typeinfo>
 #include <vector>
 
@@ -52,6 +54,12 @@ class SideData;
  * float, and int).  To use this class with other user-defined types,
  * many of these functions will need to be specialized, especially those
  * that deal with message packing and unpacking.
+ *
+ * The array storage is obtained from a tbox::MemoryAllocator, by default
+ * the one returned by tbox::MemoryAllocator::getCurrent() when the array
+ * is constructed.  The storage is value-initialized, like a std::vector,
+ * unless the allocator's getInitializeMemory() is false and TYPE is
+ * trivially default constructible, in which case it is left uninitialized.
  */
 
 template<class TYPE>
@@ -103,6 +111,23 @@ public:
       const hier::Box& box,
       unsigned int depth);
 
+   /*!
+    * Construct an array data object with storage from the given allocator.
+    *
+    * @param box   Const reference to box object describing the spatial extents
+    *              of the index space associated with the array data object.
+    * @param depth Integer number of data values at each spatial location in
+    *              the array.
+    * @param allocator Allocator providing the array storage.
+    *
+    * @pre depth > 0
+    * @pre allocator
+    */
+   ArrayData(
+      const hier::Box& box,
+      unsigned int depth,
+      const std::shared_ptr<tbox::MemoryAllocator>& allocator);
+
    /*!
     * The destructor for an array data object releases all memory allocated
     * for the array elements.
@@ -595,6 +620,15 @@ public:
    const tbox::Dimension&
    getDim() const;
 
+   /*!
+    * @brief Return the allocator providing the array storage.
+    */
+   const std::shared_ptr<tbox::MemoryAllocator>&
+   getAllocator() const
+   {
+      return d_allocator;
+   }
+
    /**
     * @brief Returns true if the array is valid.
     */
@@ -651,6 +685,18 @@ private:
       const TYPE* buffer,
       const hier::Box& box);
 
+   /*
+    * Private member function to get a pointer to the next size items
+    * of the stream, advancing the stream.  The stream buffer is read in
+    * place if it is suitably aligned; otherwise the items are copied
+    * into the staging vector.
+    */
+   static const TYPE *
+   getUnpackBuffer(
+      tbox::MessageStream& stream,
+      size_t size,
+      std::vector<TYPE>& staging);
+
    /*!
     * @brief Compte index into d_array for data at index i and depth d.
     *
@@ -666,10 +712,20 @@ private:
       const hier::Index& i,
       unsigned int d) const;
 
+   /*
+    * Private member functions to obtain storage for d_depth * d_offset
+    * items from the allocator and to release it.
+    */
+   void
+   allocateArray();
+   void
+   deallocateArray();
+
    unsigned int d_depth;
    size_t d_offset;
    hier::Box d_box;
-   std::vector<TYPE> d_array;
+   std::shared_ptr<tbox::MemoryAllocator> d_allocator;
+   TYPE* d_array;
 };
 
 }
@@ -14,6 +14,7 @@
 #include "SAMRAI/SAMRAI_config.h"
 
 #include "SAMRAI/hier/Box.h"
+#include "SAMRAI/hier/BoxLoop.h"
 #include "SAMRAI/hier/IntVector.h"
 
 namespace SAMRAI {
@@ -22,6 +23,208 @@ namespace pdat {
 template<class TYPE>
 class ArrayData;
 
+/*!
+ * @brief Row offsets of an array for the row bodies below.
+ *
+ * Maps the first index of a row, as passed by hier::BoxLoop, to the
+ * offset of that cell in an array with the given box.  The strides of
+ * the array are computed once, and the offset of a row is evaluated by
+ * a kernel with the dimension as a template parameter, so there is no
+ * loop over the runtime dimension for each row.
+ */
+class ArrayDataRowOffset
+{
+public:
+   /*!
+    * @param array_box  Box of the array.
+    * @param shift  Shift from the loop index space to the array index
+    *               space; the array entry for index i is at i - shift.
+    */
+   ArrayDataRowOffset(
+      const hier::Box& array_box,
+      const hier::IntVector& shift):
+      d_dim(array_box.getDim().getValue()),
+      d_origin(0)
+   {
+      long stride = 1;
+      for (tbox::Dimension::dir_t d = 0; d < d_dim; ++d) {
+         d_stride[d] = stride;
+         d_origin += stride * (array_box.lower(d) + shift(d));
+         stride *= array_box.numberCells(d);
+      }
+   }
+
+   /*!
+    * Return the offset in the array of the cell at index.
+    */
+   size_t
+   operator () (
+      const int* index) const
+   {
+      switch (d_dim) {
+         case 1:
+            return offset<1>(index);
+         case 2:
+            return offset<2>(index);
+         case 3:
+            return offset<3>(index);
+         default:
+            return offset<SAMRAI::MAX_DIM_VAL>(index);
+      }
+   }
+
+private:
+   /*
+    * Offset of index in an array of dimension DIM.  The general case
+    * only arises when SAMRAI is configured for more than three
+    * dimensions, and then uses d_dim.
+    */
+   template<int DIM>
+   size_t
+   offset(
+      const int* index) const
+   {
+      const int dim = DIM <= 3 ? DIM : d_dim;
+      long result = -d_origin;
+      for (int d = 0; d < dim; ++d) {
+         result += d_stride[d] * index[d];
+      }
+      return static_cast<size_t>(result);
+   }
+
+   int d_dim;
+   long d_origin;
+   long d_stride[SAMRAI::MAX_DIM_VAL];
+};
+
+/*!
+ * @brief hier::BoxLoop row body applying an operation to corresponding
+ * rows of a destination and a source array.
+ */
+template<class TYPE, class OP>
+class ArrayDataOperationRow
+{
+public:
+   ArrayDataOperationRow(
+      TYPE* dst_ptr,
+      const hier::Box& dst_box,
+      const TYPE* src_ptr,
+      const hier::Box& src_box,
+      const hier::IntVector& src_shift,
+      const OP& op):
+      d_dst_ptr(dst_ptr),
+      d_src_ptr(src_ptr),
+      d_dst_offset(dst_box, hier::IntVector::getZero(dst_box.getDim())),
+      d_src_offset(src_box, src_shift),
+      d_op(op)
+   {
+   }
+
+   void
+   operator () (
+      const int* index,
+      int length) const
+   {
+      TYPE * const dst = d_dst_ptr + d_dst_offset(index);
+      const TYPE * const src = d_src_ptr + d_src_offset(index);
+      for (int i = 0; i < length; ++i) {
+         d_op(dst[i], src[i]);
+      }
+   }
+
+private:
+   TYPE* d_dst_ptr;
+   const TYPE* d_src_ptr;
+   ArrayDataRowOffset d_dst_offset;
+   ArrayDataRowOffset d_src_offset;
+   const OP& d_op;
+};
+
+/*!
+ * @brief hier::BoxLoop row body applying an operation between rows of an
+ * array and consecutive sections of a buffer.
+ *
+ * The buffer position advances with each row, so the rows must be
+ * visited in order.
+ */
+template<class TYPE, class OP>
+class ArrayDataBufferOperationRow
+{
+public:
+   ArrayDataBufferOperationRow(
+      TYPE* array_ptr,
+      const hier::Box& array_box,
+      TYPE* buffer,
+      bool src_is_buffer,
+      const OP& op):
+      d_array_ptr(array_ptr),
+      d_buffer(buffer),
+      d_src_is_buffer(src_is_buffer),
+      d_offset(array_box, hier::IntVector::getZero(array_box.getDim())),
+      d_op(op)
+   {
+   }
+
+   void
+   operator () (
+      const int* index,
+      int length)
+   {
+      TYPE * const row = d_array_ptr + d_offset(index);
+      if (d_src_is_buffer) {
+         for (int i = 0; i < length; ++i) {
+            d_op(row[i], d_buffer[i]);
+         }
+      } else {
+         for (int i = 0; i < length; ++i) {
+            d_op(d_buffer[i], row[i]);
+         }
+      }
+      d_buffer += length;
+   }
+
+private:
+   TYPE* d_array_ptr;
+   TYPE* d_buffer;
+   bool d_src_is_buffer;
+   ArrayDataRowOffset d_offset;
+   const OP& d_op;
+};
+
+/*!
+ * @brief hier::BoxLoop row body setting rows of an array to a value.
+ */
+template<class TYPE>
+class ArrayDataFillRow
+{
+public:
+   ArrayDataFillRow(
+      TYPE* array_ptr,
+      const hier::Box& array_box,
+      const TYPE& value):
+      d_array_ptr(array_ptr),
+      d_offset(array_box, hier::IntVector::getZero(array_box.getDim())),
+      d_value(value)
+   {
+   }
+
+   void
+   operator () (
+      const int* index,
+      int length) const
+   {
+      TYPE * const row = d_array_ptr + d_offset(index);
+      for (int i = 0; i < length; ++i) {
+         row[i] = d_value;
+      }
+   }
+
+private:
+   TYPE* d_array_ptr;
+   ArrayDataRowOffset d_offset;
+   const TYPE& d_value;
+};
+
 /*!
  * @brief Struct ArrayDataOperationUtilities<TYPE, OP> provides
  * generic looping operations for all array-based patch data types.
@@ -23,6 +23,7 @@
 #include "SAMRAI/tbox/Utilities.h"
 
 #include <memory>
+#include <vector>
 
 namespace SAMRAI {
 namespace solv {
@@ -239,6 +240,35 @@ public:
       int target_data_id,
       bool homogeneous_bc = false) const;
 
+   /*!
+    * @brief Set the first ghost cells across the given boundary boxes.
+    *
+    * The boxes are codimension-one boundary boxes, which need not be
+    * the boundary boxes of the patch: they may be anywhere in the ghost
+    * box of the data, for instance next to neighbor cells that the
+    * caller updates in the ghost region of the patch.  Each box must be
+    * outside the physical domain and next to cells in the ghost box
+    * across the face given by its location index.  The values are set
+    * as in setBoundaryValuesInCells(), but only in the boxes given.
+    *
+    * @param patch hier::Patch on which to set boundary condition
+    * @param boundary_boxes Codimension-one boundary boxes to set
+    * @param fill_time Solution time corresponding to filling
+    * @param target_data_id hier::Patch data index of data to be set.
+    *        This data must be a cell-centered double.
+    * @param homogeneous_bc Set a homogeneous boundary condition.
+    *    This means g=0 for the boundary.
+    *
+    * @pre d_coef_strategy
+    */
+   void
+   setBoundaryValuesInBoundaryBoxes(
+      hier::Patch& patch,
+      const std::vector<hier::BoundaryBox>& boundary_boxes,
+      const double fill_time,
+      int target_data_id,
+      bool homogeneous_bc = false) const;
+
    /*!
     * @brief Set the physical boundary condition by setting the
     * value of the boundary nodes.
@@ -440,6 +470,19 @@ private:
    makeFaceBoundaryBox(
       const hier::BoundaryBox& boundary_box) const;
 
+   /*!
+    * @brief Set the ghost cells of a codimension-one boundary box
+    * from the Robin coefficients and the interior cells next to it.
+    */
+   void
+   setBoundaryValuesInBoundaryBox(
+      hier::Patch& patch,
+      pdat::CellData<double>& data,
+      const std::shared_ptr<hier::Variable>& variable,
+      const hier::BoundaryBox& boundary_box,
+      const double fill_time,
+      bool homogeneous_bc) const;
+
    std::string d_object_name;
 
    const tbox::Dimension d_dim;
@@ -45,8 +45,10 @@
 #include "SAMRAI/tbox/Timer.h"
 #include "SAMRAI/tbox/Utilities.h"
 
+#include <map>
 #include <string>
 #include <memory>
+#include <vector>
 
 namespace SAMRAI {
 namespace solv {
@@ -116,6 +118,19 @@ namespace solv {
  *
  *    - \b    prolongation_method
  *
+ *    - \b    smoothing_exchange_depth
+ *       Number of red or black half-sweeps the smoother performs between
+ *       ghost exchanges.  With a depth of n, n layers of ghost cells are
+ *       filled in one exchange and the smoother sweeps locally over the
+ *       patch box grown by n-1, n-2, ..., 0 cells, updating the cells of
+ *       neighboring patches redundantly.  This replaces the exchange
+ *       after every half-sweep by one every n half-sweeps.  Physical
+ *       boundary ghosts of the neighboring cells are reset after every
+ *       half-sweep, so the result is the same as with depth 1.  Depths
+ *       greater than 1 are used only with constant D, constant or zero
+ *       C, and boundary condition coefficients whose
+ *       numberOfExtensionsFillable() is at least n-1.
+ *
  *    - \b    enable_logging
  *
  * <b> Details:</b> <br>
@@ -169,6 +184,14 @@ namespace solv {
  *     <td>Not written to restart.  Value in input db used.</td>
  *   </tr>
  *   <tr>
+ *     <td>smoothing_exchange_depth</td>
+ *     <td>int</td>
+ *     <td>1</td>
+ *     <td>>=1</td>
+ *     <td>opt</td>
+ *     <td>Not written to restart.  Value in input db used.</td>
+ *   </tr>
+ *   <tr>
  *     <td>enable_logging</td>
  *     <td>bool</td>
  *     <td>FALSE</td>
@@ -522,6 +545,54 @@ private:
       int num_sweeps,
       double residual_tolerance = -1.0);
 
+   /*!
+    * @brief Red-black Gauss-Seidel error smoothing on a level, exchanging
+    * ghost cells once every d_smoothing_exchange_depth half-sweeps.
+    *
+    * Arguments are as for smoothErrorByRedBlack().  The error and
+    * residual are copied into scratch data with d_smoothing_exchange_depth
+    * ghost cells, which are smoothed over the shrinking grown patch boxes
+    * between exchanges.  The residual tolerance is checked after each
+    * exchange interval but the last against the residual of the last
+    * half-sweep of the interval, skipping the checks that the observed
+    * convergence rate predicts to fail.  The last interval also smooths
+    * the first ghost layer, which then needs no ghost fill.
+    *
+    * @pre d_smoothing_exchange_depth > 1
+    * @pre d_poisson_spec.dIsConstant() && !d_poisson_spec.cIsVariable()
+    */
+   void
+   smoothErrorByRedBlackDeepGhosts(
+      SAMRAIVectorReal<double>& error,
+      const SAMRAIVectorReal<double>& residual,
+      int ln,
+      int num_sweeps,
+      double residual_tolerance);
+
+   /*!
+    * @brief Record, for each patch of each level, the cells of the deep
+    * ghost region not covered by the level, the physical boundaries
+    * crossing the region and, for the Ewing discretization, the
+    * coarse-fine boundaries crossing the region.
+    *
+    * The smoother holds the uncovered cells fixed between ghost
+    * exchanges, resets the physical boundary ghosts of all the cells
+    * it smooths, and corrects the flux on all the coarse-fine
+    * boundaries it smooths across, not just those of the patch.
+    */
+   void
+   findDeepGhostBoundaries();
+
+   /*!
+    * @brief Set the physical boundary ghosts of the deep-ghost cell
+    * scratch data of a patch on level ln, across every physical
+    * boundary in the deep ghost region.
+    */
+   void
+   setDeepPhysicalBoundaryConditions(
+      hier::Patch& patch,
+      int ln);
+
    /*!
     * @brief Solve the coarsest level using HYPRE
     */
@@ -605,6 +676,41 @@ private:
       char red_or_black,
       double* p_maxres = 0) const;
 
+   /*!
+    * @brief Red or black smoothing on a patch box grown into the ghost
+    * region, for constant diffusion coefficient and constant or zero
+    * scalar field.
+    *
+    * The flux is computed on the grown box before smoothing.  The data
+    * must have at least growth+1 (soln_data) or growth (flux_data and
+    * rhs_data) ghost cells, and the flux is corrected on the given
+    * coarse-fine boundary boxes.
+    *
+    * @param patch patch
+    * @param growth number of cells by which the patch box is grown
+    * @param cf_boxes coarse-fine boundary boxes for the Ewing correction
+    * @param ratio_to_coarser_level refinement ratio from coarser level
+    * @param flux_data side-centered flux scratch data
+    * @param rhs_data cell-centered rhs data
+    * @param soln_data cell-centered solution data
+    * @param red_or_black red-black switch.  Set to 'r' or 'b'.
+    * @param p_maxres max residual output.  Set to NULL to avoid computing.
+    *
+    * @pre (red_or_black == 'r') || (red_or_black == 'b')
+    * @pre d_poisson_spec.dIsConstant() && !d_poisson_spec.cIsVariable()
+    */
+   void
+   redOrBlackSmoothingOnGrownBox(
+      const hier::Patch& patch,
+      int growth,
+      const std::vector<hier::BoundaryBox>& cf_boxes,
+      const hier::IntVector& ratio_to_coarser_level,
+      pdat::SideData<double>& flux_data,
+      const pdat::CellData<double>& rhs_data,
+      pdat::CellData<double>& soln_data,
+      char red_or_black,
+      double* p_maxres) const;
+
    //@}
 
    //@{ @name For executing, caching and resetting communication schedules.
@@ -753,6 +859,37 @@ private:
       int dst_id,
       int dest_ln);
 
+   /*!
+    * @brief Execute schedule for filling the smoother scratch data,
+    * interiors and deep ghosts, from the error src_id and the residual
+    * rhs_src_id.
+    *
+    * The error ghosts are filled from the same level, the coarser level
+    * (if dest_ln > d_ln_min) and physical bc.  The residual ghosts are
+    * filled from the same level only.
+    *
+    * @pre d_deep_ghostfill_refine_schedules[dest_ln]
+    */
+   void
+   xeqScheduleDeepGhostFill(
+      int src_id,
+      int rhs_src_id,
+      int dest_ln);
+
+   /*!
+    * @brief Execute schedule for exchanging the deep ghosts of data
+    * dst_id with other patches on the same level.
+    *
+    * No physical boundary conditions are set.  dst_id must be the
+    * smoother scratch data or data of the same type and ghost width.
+    *
+    * @pre d_deep_exchange_schedules[dest_ln]
+    */
+   void
+   xeqScheduleDeepExchange(
+      int dst_id,
+      int dest_ln);
+
    //@}
 
    //! @brief Return the patch data index for cell scratch data.
@@ -862,6 +999,11 @@ private:
     */
    int d_coarse_solver_max_iterations;
 
+   /*!
+    * @brief Number of smoothing half-sweeps between ghost exchanges.
+    */
+   int d_smoothing_exchange_depth;
+
    /*!
     * @brief Residual tolerance to govern smoothing.
     *
@@ -914,6 +1056,9 @@ private:
    static std::shared_ptr<pdat::OutersideVariable<double> >
    s_oflux_scratch_var[SAMRAI::MAX_DIM_VAL];
 
+   static std::shared_ptr<pdat::CellVariable<double> >
+   s_deep_rhs_scratch_var[SAMRAI::MAX_DIM_VAL];
+
    /*!
     * @brief Default context of internally maintained hierarchy data.
     */
@@ -951,6 +1096,52 @@ private:
     */
    int d_oflux_scratch_id;
 
+   /*!
+    * @brief Context of the deep-ghost smoother scratch data.
+    */
+   std::shared_ptr<hier::VariableContext> d_deep_context;
+
+   /*!
+    * @brief IDs of the cell, rhs and flux scratch data of the deep-ghost
+    * smoother, or -1 if d_smoothing_exchange_depth is 1.
+    *
+    * The cell and rhs data have d_smoothing_exchange_depth ghost cells,
+    * the flux data one fewer.  They are allocated only while smoothing.
+    */
+   int d_deep_cell_scratch_id;
+   int d_deep_rhs_scratch_id;
+   int d_deep_flux_scratch_id;
+
+   /*!
+    * @brief Offsets, in the deep-ghost cell scratch data of each patch,
+    * of the cells not covered by the level.
+    *
+    * d_deep_fixed_cells[ln] maps the local id of a patch on level ln to
+    * its offsets.  Set in initializeOperatorState().
+    */
+   std::vector<std::map<hier::LocalId, std::vector<size_t> > >
+   d_deep_fixed_cells;
+
+   /*!
+    * @brief Coarse-fine boundary boxes in the deep ghost region of each
+    * patch, aligned with the coarser level cells, for the Ewing
+    * correction.
+    *
+    * Indexed like d_deep_fixed_cells.  Set in initializeOperatorState().
+    */
+   std::vector<std::map<hier::LocalId, std::vector<hier::BoundaryBox> > >
+   d_deep_cf_boxes;
+
+   /*!
+    * @brief Physical boundary boxes in the deep ghost region of each
+    * patch: the ghost cells outside the domain next to the cells the
+    * smoother may update.
+    *
+    * Indexed like d_deep_fixed_cells.  Set in initializeOperatorState().
+    */
+   std::vector<std::map<hier::LocalId, std::vector<hier::BoundaryBox> > >
+   d_deep_bc_boxes;
+
    //@}
 
    //@{
@@ -996,6 +1187,16 @@ private:
    std::vector<std::shared_ptr<xfer::RefineSchedule> >
    d_ghostfill_nocoarse_refine_schedules;
 
+   //! @brief Initial fill of smoother scratch data with deep ghosts.
+   std::shared_ptr<xfer::RefineAlgorithm> d_deep_ghostfill_refine_algorithm;
+   std::vector<std::shared_ptr<xfer::RefineSchedule> >
+   d_deep_ghostfill_refine_schedules;
+
+   //! @brief Deep ghost exchange of smoother scratch data on a level.
+   std::shared_ptr<xfer::RefineAlgorithm> d_deep_exchange_algorithm;
+   std::vector<std::shared_ptr<xfer::RefineSchedule> >
+   d_deep_exchange_schedules;
+
    //@}
 
    /*!
@@ -192,6 +192,34 @@ protected:
    maxNorm(
       bool local_only = false) const = 0;
 
+   /**
+    * Compute the dot products of this vector with each of the nv vectors
+    * in y, as dotWith() would, and store them in val.  The default
+    * implementation calls dotWith() for each vector; subclasses may
+    * override it to combine the global reductions into one.
+    *
+    * @param local_only Flag to get results for local data only.
+    */
+   virtual void
+   dotWithMulti(
+      const int nv,
+      const PETScAbstractVectorReal<TYPE>* const* y,
+      TYPE* val,
+      bool local_only = false) const;
+
+   /**
+    * Compute the @f$ L_1 @f$ - and @f$ L_2 @f$ -norms of this vector.  The
+    * default implementation calls L1Norm() and L2Norm(); subclasses may
+    * override it to combine the global reductions into one.
+    *
+    * @param local_only Flag to get results for local data only.
+    */
+   virtual void
+   L1AndL2Norms(
+      TYPE& l1_norm,
+      TYPE& l2_norm,
+      bool local_only = false) const;
+
    /**
     * Multiply each entry of this vector by given scalar.
     */
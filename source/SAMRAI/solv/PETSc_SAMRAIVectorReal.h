@@ -216,6 +216,27 @@ private:
    maxNorm(
       bool local_only = false) const;
 
+   /*
+    * Compute the dot products of this vector with each of the nv vectors
+    * in y using a single global reduction.
+    */
+   virtual void
+   dotWithMulti(
+      const int nv,
+      const PETScAbstractVectorReal<TYPE>* const* y,
+      TYPE* val,
+      bool local_only = false) const;
+
+   /*
+    * Compute the \f$L_1\f$- and \f$L_2\f$-norms of this vector using a
+    * single global reduction.
+    */
+   virtual void
+   L1AndL2Norms(
+      TYPE& l1_norm,
+      TYPE& l2_norm,
+      bool local_only = false) const;
+
    /*
     * Multiply each entry of this vector by given scalar.
     */
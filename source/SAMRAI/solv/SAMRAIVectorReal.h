@@ -23,6 +23,7 @@
 #include <string>
 #include <iostream>
 #include <memory>
+#include <vector>
 
 namespace SAMRAI {
 namespace solv {
@@ -84,6 +85,10 @@ namespace solv {
  * the user's part.  See the documentation accompanying the addComponent()
  * function for more information.
  *
+ * The norms and dot products accumulate the local contributions of all
+ * components before doing a single global reduction, rather than one
+ * reduction per component.
+ *
  * @see math::HierarchyDataOpsReal
  */
 
@@ -600,6 +605,34 @@ public:
       const std::shared_ptr<SAMRAIVectorReal<TYPE> >& x,
       bool local_only = false) const;
 
+   /**
+    * Compute the dot products of this vector with each of the vectors in
+    * x, as dot() would, and store them in dots.  The local contributions
+    * of every vector, component and level are accumulated first and then
+    * combined in one global reduction, so the cost in messages does not
+    * grow with the number of vectors.  This is intended for Krylov methods
+    * that need several inner products at once.  If local_only is true,
+    * the global reduction is not performed.
+    *
+    * @post dots.size() == x.size()
+    */
+   void
+   multiDot(
+      const std::vector<std::shared_ptr<SAMRAIVectorReal<TYPE> > >& x,
+      std::vector<TYPE>& dots,
+      bool local_only = false) const;
+
+   /**
+    * Compute the @f$ L_1 @f$ - and @f$ L_2 @f$ -norms of this vector, as
+    * L1Norm() and L2Norm() would, using a single global reduction.  If
+    * local_only is true, the global reduction is not performed.
+    */
+   void
+   L1AndL2Norms(
+      double& l1_norm,
+      double& l2_norm,
+      bool local_only = false) const;
+
    /**
     * Return 1 if @f$ \|x_i\| > 0 @f$  and @f$ w_i * x_i \leq 0 @f$ , for any @f$ i @f$  in
     * the set of vector data indices, where @f$ cvol_i > 0 @f$ .  Here, @f$ w_i @f$  is
@@ -670,6 +703,26 @@ private:
    operator = (
       const SAMRAIVectorReal&);
 
+   /*
+    * Private member functions returning the local (unreduced) sum of the
+    * squared component weighted L2 norms and the local sum of the control
+    * volumes of the components that have them.  These let the RMS norms
+    * combine both sums in one global reduction.
+    */
+   double
+   localWeightedL2NormSquared(
+      const std::shared_ptr<SAMRAIVectorReal<TYPE> >& wgt) const;
+
+   double
+   localControlVolumeSum() const;
+
+   /*
+    * Private member function returning the global number of interior
+    * entries in the components that have no control volume.
+    */
+   double
+   globalEntriesWithoutControlVolume() const;
+
    /*
     * Private member function to set number of vector components.  This
     * is used during cloning.
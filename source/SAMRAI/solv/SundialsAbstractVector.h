@@ -177,6 +177,18 @@ public:
    dotWith(
       const SundialsAbstractVector* x) const = 0;
 
+   /**
+    * Compute the dot products of this vector with each of the num_vectors
+    * vectors in x and store them in dots.  The default implementation calls
+    * dotWith() for each vector; subclasses may override it to combine the
+    * global reductions of all the dot products into one.
+    */
+   virtual void
+   dotWithMulti(
+      const int num_vectors,
+      const SundialsAbstractVector* const* x,
+      double* dots) const;
+
    /**
     * Return the max norm of this vector.
     */
@@ -229,6 +229,16 @@ private:
    dotWith(
       const SundialsAbstractVector* x) const;
 
+   /*
+    * Compute the dot products of this vector and each of the vectors in
+    * \f$x\f$ using a single global reduction.
+    */
+   void
+   dotWithMulti(
+      const int num_vectors,
+      const SundialsAbstractVector* const* x,
+      double* dots) const;
+
    /*
     * Return the max norm of this vector:
     * \f${\| v \|}_{\max} = \max_{i} (\mid v_i \mid)\f$.
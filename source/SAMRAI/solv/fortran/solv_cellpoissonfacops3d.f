@@ -199,7 +199,7 @@ c***********************************************************************
       do k=kfirst,klast
       do j=jfirst,jlast
 c        offset must be 0 (red) or 1 (black)
-         if ( (ifirst+j+k)-((ifirst+j+k)/2*2) .ne. offset ) then
+         if ( abs(mod(ifirst+j+k,2)) .ne. offset ) then
             ioffset = 1
          else
             ioffset = 0
@@ -283,7 +283,7 @@ c***********************************************************************
       do k=kfirst,klast
       do j=jfirst,jlast
 c        offset must be 0 (red) or 1 (black)
-         if ( (ifirst+j+k)-((ifirst+j+k)/2*2) .ne. offset ) then
+         if ( abs(mod(ifirst+j+k,2)) .ne. offset ) then
             ioffset = 1
          else
             ioffset = 0
@@ -373,7 +373,7 @@ c***********************************************************************
       do k=kfirst,klast
       do j=jfirst,jlast
 c        offset must be 0 (red) or 1 (black)
-         if ( (ifirst+j+k)-((ifirst+j+k)/2*2) .ne. offset ) then
+         if ( abs(mod(ifirst+j+k,2)) .ne. offset ) then
             ioffset = 1
          else
             ioffset = 0
@@ -455,7 +455,7 @@ c***********************************************************************
       do k=kfirst,klast
       do j=jfirst,jlast
 c        offset must be 0 (red) or 1 (black)
-         if ( (ifirst+j+k)-((ifirst+j+k)/2*2) .ne. offset ) then
+         if ( abs(mod(ifirst+j+k,2)) .ne. offset ) then
             ioffset = 1
          else
             ioffset = 0
@@ -0,0 +1,80 @@
+/*************************************************************************
+ *
+ * This file is part of the SAMRAI distribution.  For full copyright
+ * information, see COPYRIGHT and LICENSE.
+ *
+ * Copyright:     (c) 1997-2017 Lawrence Livermore National Security, LLC
+ * Description:   Allocator of array storage with a given alignment
+ *
+ ************************************************************************/
+
+#ifndef included_tbox_AlignedAllocator
+#define included_tbox_AlignedAllocator
+
+#include "SAMRAI/SAMRAI_config.h"
+
+#include "SAMRAI/tbox/MemoryAllocator.h"
+
+namespace SAMRAI {
+namespace tbox {
+
+/*!
+ * @brief Class AlignedAllocator allocates each request from the general
+ * heap, aligned to a given power-of-two boundary.
+ *
+ * The default alignment of 64 bytes is the size of a cache line and of
+ * the widest SIMD registers on current processors, so kernels operating
+ * on arrays from this allocator may assume aligned loads and stores at
+ * the start of each array.
+ */
+
+class AlignedAllocator:public MemoryAllocator
+{
+public:
+   /*!
+    * @brief Constructor.
+    *
+    * @param[in] name       Name used when reporting memory usage.
+    * @param[in] alignment  Alignment in bytes.
+    *
+    * @pre alignment is a power of two no smaller than sizeof(void*)
+    */
+   explicit AlignedAllocator(
+      const std::string& name = "aligned",
+      size_t alignment = 64);
+
+   /*!
+    * @brief Destructor.
+    */
+   virtual ~AlignedAllocator();
+
+   /*!
+    * @brief Return the alignment given to the constructor.
+    */
+   virtual size_t
+   getAlignment() const;
+
+protected:
+   virtual void *
+   allocateBytes(
+      size_t bytes);
+
+   virtual void
+   deallocateBytes(
+      void* ptr,
+      size_t bytes);
+
+private:
+   AlignedAllocator(
+      const AlignedAllocator&);                // not implemented
+   AlignedAllocator&
+   operator = (
+      const AlignedAllocator&);                // not implemented
+
+   size_t d_alignment;
+};
+
+}
+}
+
+#endif
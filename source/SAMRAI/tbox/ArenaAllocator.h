@@ -0,0 +1,157 @@
+/*************************************************************************
+ *
+ * This file is part of the SAMRAI distribution.  For full copyright
+ * information, see COPYRIGHT and LICENSE.
+ *
+ * Copyright:     (c) 1997-2017 Lawrence Livermore National Security, LLC
+ * Description:   Allocator of array storage from large chunks of memory
+ *
+ ************************************************************************/
+
+#ifndef included_tbox_ArenaAllocator
+#define included_tbox_ArenaAllocator
+
+#include "SAMRAI/SAMRAI_config.h"
+
+#include "SAMRAI/tbox/MemoryAllocator.h"
+
+#include <map>
+#include <vector>
+
+namespace SAMRAI {
+namespace tbox {
+
+/*!
+ * @brief Class ArenaAllocator carves storage out of large chunks of
+ * memory obtained from the heap.
+ *
+ * Requests are rounded up to the alignment and taken from the end of the
+ * last chunk; a new chunk is obtained when the last one is full.  Released
+ * blocks are kept on a free list by size and handed out again for
+ * requests of the same size, which is the common case for patch data
+ * that is repeatedly allocated and deallocated on the same patches.  When
+ * every block has been released, all chunks but the first are returned
+ * to the heap and the arena starts over.
+ *
+ * An arena is meant to hold the data of one patch level (see
+ * hier::PatchLevel::setAllocator() and
+ * SAMRAIManager::setLevelArenaChunkBytes()).  All memory of a level then
+ * comes from a few large chunks that are released together when the
+ * level goes away, which keeps the heap from fragmenting over many
+ * regrids.
+ */
+
+class ArenaAllocator:public MemoryAllocator
+{
+public:
+   /*!
+    * @brief Constructor.
+    *
+    * No memory is obtained until the first allocation.
+    *
+    * @param[in] name         Name used when reporting memory usage.
+    * @param[in] chunk_bytes  Size of the chunks obtained from the heap.
+    *                         Larger requests get a chunk of their own.
+    * @param[in] alignment    Alignment in bytes of every block.
+    *
+    * @pre chunk_bytes > 0
+    * @pre alignment is a power of two no smaller than sizeof(void*)
+    */
+   ArenaAllocator(
+      const std::string& name,
+      size_t chunk_bytes,
+      size_t alignment = 64);
+
+   /*!
+    * @brief The destructor returns all chunks to the heap.
+    */
+   virtual ~ArenaAllocator();
+
+   /*!
+    * @brief Return the alignment given to the constructor.
+    */
+   virtual size_t
+   getAlignment() const;
+
+   /*!
+    * @brief Return the total size of the chunks held by the arena.
+    */
+   virtual size_t
+   getBytesReserved() const;
+
+   /*!
+    * @brief Return the high-water mark of getBytesReserved().
+    */
+   virtual size_t
+   getMaxBytesReserved() const;
+
+   /*!
+    * @brief Return the chunk size given to the constructor.
+    */
+   size_t
+   getChunkBytes() const
+   {
+      return d_chunk_bytes;
+   }
+
+protected:
+   virtual void *
+   allocateBytes(
+      size_t bytes);
+
+   virtual void
+   deallocateBytes(
+      void* ptr,
+      size_t bytes);
+
+private:
+   ArenaAllocator(
+      const ArenaAllocator&);                // not implemented
+   ArenaAllocator&
+   operator = (
+      const ArenaAllocator&);                // not implemented
+
+   struct Chunk {
+      char* d_block;   // Start of the memory from the heap.
+      char* d_data;    // First aligned address in the block.
+      size_t d_size;   // Usable bytes starting at d_data.
+   };
+
+   /*
+    * Round bytes up to the alignment.
+    */
+   size_t
+   roundUp(
+      size_t bytes) const
+   {
+      return (bytes + d_alignment - 1) & ~(d_alignment - 1);
+   }
+
+   void
+   addChunk(
+      size_t size);
+
+   size_t d_chunk_bytes;
+   size_t d_alignment;
+
+   std::vector<Chunk> d_chunks;
+
+   /*
+    * Number of bytes used at the start of the last chunk.
+    */
+   size_t d_last_chunk_used;
+
+   /*
+    * Released blocks by rounded size.
+    */
+   std::map<size_t, std::vector<char *> > d_free_blocks;
+
+   size_t d_num_live_blocks;
+   size_t d_bytes_reserved;
+   size_t d_max_bytes_reserved;
+};
+
+}
+}
+
+#endif
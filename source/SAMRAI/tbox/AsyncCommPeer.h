@@ -161,8 +161,41 @@ public:
    {
       d_max_first_data_len = max_first_data_len;
    }
+
+   /*!
+    * @brief Return the data length limit of the first message.
+    *
+    * @see limitFirstDataLength()
+    */
+   size_t
+   getFirstDataLengthLimit() const
+   {
+      return d_max_first_data_len;
+   }
    //@}
 
+   /*!
+    * @brief Set whether to use persistent MPI requests.
+    *
+    * With persistent requests, the first (and usually only) message of
+    * a send or receive is set up once with MPI_Send_init or
+    * MPI_Recv_init.  Later operations restart it with MPI_Start as
+    * long as the message length and MPI parameters do not change.
+    * This saves the setup cost of MPI_Isend and MPI_Irecv for objects
+    * that repeatedly exchange messages of the same size.  The second
+    * message of a split message (see limitFirstDataLength()) always
+    * uses nonpersistent requests.
+    *
+    * The default is to not use persistent requests.
+    *
+    * @param flag
+    *
+    * @pre isDone()
+    */
+   void
+   setUsePersistentRequests(
+      bool flag);
+
    /*!
     * @brief Set the MPI tags used for communication.
     *
@@ -264,7 +297,9 @@ public:
     * This must be paired with a beginRecv() by the peer processor.
     *
     * On return, the data in @b buffer would have been copied so it is
-    * safe to deallocate or modify @c buffer.
+    * safe to deallocate or modify @c buffer, unless @c buffer was
+    * obtained from getSendBuffer().  That data is sent in place and
+    * must not be modified until the send completes.
     *
     * @param buffer
     * @param size
@@ -283,6 +318,26 @@ public:
       int size,
       bool automatic_push_to_completion_queue = false);
 
+   /*!
+    * @brief Return an internal buffer to write the data of the next
+    * send into.
+    *
+    * Data written into this buffer and passed to beginSend() is sent
+    * in place instead of being copied.  This is possible only for data
+    * sent in a single message, so @c size may not exceed the first
+    * data length limit.  The buffer is valid until the next operation
+    * begins or the object is destroyed, and beginSend() may send at
+    * most @c size items from it.
+    *
+    * @param size  Number of items the buffer must hold.
+    *
+    * @pre isDone()
+    * @pre size <= getFirstDataLengthLimit()
+    */
+   TYPE *
+   getSendBuffer(
+      size_t size);
+
    /*!
     * @brief Check the current broadcast communication and complete
     * the broadcast if all MPI requests are fulfilled.
@@ -522,6 +577,39 @@ private:
             mpi_status.MPI_ERROR = -1;
    }
 
+   /*!
+    * @brief Start the persistent request for the first message of the
+    * current operation, setting it up first if it does not exist or
+    * does not match the operation.
+    *
+    * @param op  Operation (send or recv) the request is for.
+    * @param count  Number of FlexData in the message.
+    *
+    * @return MPI error flag.
+    */
+   int
+   startPersistentRequest(
+      BaseOp op,
+      size_t count);
+
+   /*!
+    * @brief Free the persistent request, if there is one.
+    *
+    * @pre isDone()
+    */
+   void
+   freePersistentRequest();
+
+   /*!
+    * @brief Test request ic for completion with MPI_Test.
+    *
+    * @return MPI error flag.
+    */
+   int
+   testRequest(
+      int ic,
+      int* flag);
+
    /*
     * @brief Resize the internal buffer to hold size FlexData unions.
     *
@@ -626,6 +714,33 @@ private:
     */
    bool d_report_send_completion[2];
 
+   /*!
+    * @brief Whether to use persistent requests.
+    *
+    * @see setUsePersistentRequests().
+    */
+   bool d_use_persistent_requests;
+
+   /*!
+    * @brief Persistent request for the first message, or
+    * MPI_REQUEST_NULL if it has not been set up.
+    */
+   SAMRAI_MPI::Request d_persistent_req;
+
+   /*!
+    * @brief Operation, message length (in FlexData) and buffer the
+    * persistent request was set up with.
+    */
+   BaseOp d_persistent_op;
+   size_t d_persistent_count;
+   const FlexData* d_persistent_buf;
+
+   /*!
+    * @brief Whether the persistent request has been started and not
+    * yet found complete by this object.
+    */
+   bool d_persistent_req_started;
+
    // Make some temporary variable statuses to avoid repetitious allocations.
    int d_mpi_err;
 
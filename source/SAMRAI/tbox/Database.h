@@ -34,6 +34,8 @@
 namespace SAMRAI {
 namespace tbox {
 
+class MessageStream;
+
 /**
  * @brief Class Database is an abstract base class for the input, restart,
  * and visualization databases.
@@ -1610,6 +1612,51 @@ public:
       }
    }
 
+   /**
+    * Copy the entry with the specified key name into another database,
+    * recursively for a database entry.  If the key already exists in
+    * dst, the old entry is replaced.
+    *
+    * @param key Key name in this database.
+    * @param dst Database to copy into.
+    */
+   void
+   copyKey(
+      const std::string& key,
+      Database& dst);
+
+   /**
+    * Copy all entries of this database, recursively, into another
+    * database.
+    *
+    * @param dst Database to copy into.
+    */
+   void
+   copyAllKeys(
+      Database& dst);
+
+   /**
+    * Pack all entries of this database, recursively, into a message
+    * stream.  Each entry is packed as its key, its type and its values,
+    * or for a database entry, its own entries.  The entries are added
+    * back to a database by unpackStream().
+    *
+    * @param stream Write-mode stream.
+    */
+   void
+   packStream(
+      MessageStream& stream);
+
+   /**
+    * Add to this database the entries packed into a message stream by
+    * packStream().
+    *
+    * @param stream Read-mode stream.
+    */
+   void
+   unpackStream(
+      MessageStream& stream);
+
    /**
     * @brief Returns the name of this database.
     *
@@ -44,12 +44,37 @@ namespace tbox {
  * It is assumed that all processors will access the database in the same
  * manner.  Error reporting is done using the SAMRAI error reporting macros.
  *
+ * By default arrays are stored contiguous and uncompressed.  With
+ * setCompression(), numeric, bool, box and complex arrays of at least a
+ * minimum size are stored in chunks passed through an HDF5 filter.
+ * Compressed data is read back transparently, so a file may be read
+ * with any compression setting.  Sub-databases inherit the setting of
+ * the database that created or opened them.
+ *
  * @see Database
  */
 
 class HDFDatabase:public Database
 {
 public:
+   /*!
+    * @brief Filters for compressing array datasets.
+    *
+    * - NO_COMPRESSION: contiguous, unfiltered storage.
+    * - DEFLATE: gzip compression.
+    * - SHUFFLE_DEFLATE: byte shuffle followed by gzip.  Usually better
+    *   than DEFLATE alone for smooth floating-point fields.
+    * - SZIP: lossless szip compression, used for numeric and bool
+    *   arrays when the HDF5 library provides an szip encoder.  Box and
+    *   complex arrays use SHUFFLE_DEFLATE.
+    */
+   enum CompressionType {
+      NO_COMPRESSION = 0,
+      DEFLATE = 1,
+      SHUFFLE_DEFLATE = 2,
+      SZIP = 3
+   };
+
    /**
     * The HDF database constructor creates an empty database with the
     * specified name.  By default the database will not be associated
@@ -502,6 +527,57 @@ public:
    virtual std::string
    getName();
 
+   /*!
+    * @brief Set how array datasets written from now on are stored.
+    *
+    * If the HDF5 library cannot encode with the requested filter, a
+    * warning is printed and SHUFFLE_DEFLATE (for SZIP) or
+    * NO_COMPRESSION (for the deflate filters) is used instead.
+    *
+    * @param type Compression filter.
+    * @param level gzip compression level, from 1 (fastest) to 9
+    * (smallest).  Not used by SZIP.
+    * @param chunk_size Number of array elements per chunk.
+    * @param min_compressed_size Arrays with fewer elements are stored
+    * contiguous and uncompressed, since chunking small arrays costs more
+    * than it saves.
+    *
+    * @pre (level >= 1) && (level <= 9)
+    * @pre chunk_size > 0
+    */
+   void
+   setCompression(
+      CompressionType type,
+      int level = 6,
+      size_t chunk_size = 65536,
+      size_t min_compressed_size = 1024);
+
+   /*!
+    * @brief Return the compression filter in use.
+    */
+   CompressionType
+   getCompression() const
+   {
+      return d_compression;
+   }
+
+   /*!
+    * @brief Return true if the HDF5 library can encode with the filter.
+    */
+   static bool
+   isCompressionAvailable(
+      CompressionType type);
+
+   /*!
+    * @brief Return the filter named by a string: "NONE", "DEFLATE",
+    * "SHUFFLE_DEFLATE" or "SZIP".
+    *
+    * An unknown name is an unrecoverable error.
+    */
+   static CompressionType
+   getCompressionFromString(
+      const std::string& name);
+
    /**
     * Return the group_id so VisIt can access an object's HDF database.
     */
@@ -603,6 +679,29 @@ private:
    createCompoundComplex(
       char type_spec) const;
 
+   /*!
+    * @brief Create the dataset creation property list for an array of
+    * nelements.
+    *
+    * Returns H5P_DEFAULT if the array is stored uncompressed.
+    * Otherwise the caller closes the list with H5Pclose(hid_t).
+    *
+    * @param nelements Number of elements in the array.
+    * @param is_compound Whether the array type is a compound type,
+    * which szip cannot encode.
+    */
+   hid_t
+   createDatasetProperties(
+      size_t nelements,
+      bool is_compound) const;
+
+   /*!
+    * @brief Give a sub-database the compression setting of this one.
+    */
+   void
+   copyCompression(
+      HDFDatabase& database) const;
+
    /*
     * Private utility routines for searching keys in database;
     */
@@ -693,6 +792,14 @@ private:
     */
    std::list<KeyData> d_keydata;
 
+   /*
+    * Compression of array datasets.  See setCompression().
+    */
+   CompressionType d_compression;
+   int d_compression_level;
+   size_t d_chunk_size;
+   size_t d_min_compressed_size;
+
    /*
     *************************************************************************
     *
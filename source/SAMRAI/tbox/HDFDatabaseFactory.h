@@ -14,13 +14,84 @@
 #include "SAMRAI/SAMRAI_config.h"
 #include "SAMRAI/tbox/DatabaseFactory.h"
 
+#include <string>
+
 namespace SAMRAI {
 namespace tbox {
 
 /**
  * @brief HDFDatabase factory.
  *
- * Builds a new HDFDatabase.
+ * Builds a new HDFDatabase.  The compression of array datasets in the
+ * databases built may be set with setCompression() or from input.  By
+ * default arrays are not compressed.
+ *
+ * <b> Input Parameters </b>
+ *
+ * <b> Definitions: </b>
+ *    - \b    compression
+ *       Filter used for array datasets: "NONE", "DEFLATE",
+ *       "SHUFFLE_DEFLATE" or "SZIP".  See HDFDatabase::CompressionType.
+ *
+ *    - \b    compression_level
+ *       gzip compression level, from 1 (fastest) to 9 (smallest).
+ *
+ *    - \b    chunk_size
+ *       Number of array elements per chunk.
+ *
+ *    - \b    min_compressed_size
+ *       Arrays with fewer elements are stored uncompressed.
+ *
+ * <b> Details: </b> <br>
+ * <table>
+ *   <tr>
+ *     <th>parameter</th>
+ *     <th>type</th>
+ *     <th>default</th>
+ *     <th>range</th>
+ *     <th>opt/req</th>
+ *     <th>behavior on restart</th>
+ *   </tr>
+ *   <tr>
+ *     <td>compression</td>
+ *     <td>string</td>
+ *     <td>"NONE"</td>
+ *     <td>"NONE", "DEFLATE", "SHUFFLE_DEFLATE", "SZIP"</td>
+ *     <td>opt</td>
+ *     <td>Not written to restart.  Value in input db used.</td>
+ *   </tr>
+ *   <tr>
+ *     <td>compression_level</td>
+ *     <td>int</td>
+ *     <td>6</td>
+ *     <td>1-9</td>
+ *     <td>opt</td>
+ *     <td>Not written to restart.  Value in input db used.</td>
+ *   </tr>
+ *   <tr>
+ *     <td>chunk_size</td>
+ *     <td>int</td>
+ *     <td>65536</td>
+ *     <td>>0</td>
+ *     <td>opt</td>
+ *     <td>Not written to restart.  Value in input db used.</td>
+ *   </tr>
+ *   <tr>
+ *     <td>min_compressed_size</td>
+ *     <td>int</td>
+ *     <td>1024</td>
+ *     <td>>=0</td>
+ *     <td>opt</td>
+ *     <td>Not written to restart.  Value in input db used.</td>
+ *   </tr>
+ * </table>
+ *
+ * A sample input file entry might look like:
+ *
+ * @code
+ *    compression = "SHUFFLE_DEFLATE"
+ *    compression_level = 4
+ * @endcode
  */
 class HDFDatabaseFactory:public DatabaseFactory
 {
@@ -54,6 +125,38 @@ public:
    virtual std::shared_ptr<Database>
    allocate(
       const std::string& name);
+
+   /**
+    * Set the compression of array datasets in the databases built from
+    * now on.  The arguments are those of HDFDatabase::setCompression(),
+    * with the filter given by name as in the compression input.
+    *
+    * @pre (level >= 1) && (level <= 9)
+    * @pre chunk_size > 0
+    */
+   void
+   setCompression(
+      const std::string& compression,
+      int level = 6,
+      size_t chunk_size = 65536,
+      size_t min_compressed_size = 1024);
+
+   /**
+    * Read the compression of array datasets from input.  See the class
+    * documentation for the parameters.
+    */
+   void
+   getFromInput(
+      const std::shared_ptr<Database>& input_db);
+
+private:
+   /*
+    * Compression of array datasets in the databases built.
+    */
+   std::string d_compression;
+   int d_compression_level;
+   size_t d_chunk_size;
+   size_t d_min_compressed_size;
 };
 
 }
@@ -0,0 +1,72 @@
+/*************************************************************************
+ *
+ * This file is part of the SAMRAI distribution.  For full copyright
+ * information, see COPYRIGHT and LICENSE.
+ *
+ * Copyright:     (c) 1997-2017 Lawrence Livermore National Security, LLC
+ * Description:   Allocator of array storage from the general heap
+ *
+ ************************************************************************/
+
+#ifndef included_tbox_HeapAllocator
+#define included_tbox_HeapAllocator
+
+#include "SAMRAI/SAMRAI_config.h"
+
+#include "SAMRAI/tbox/MemoryAllocator.h"
+
+namespace SAMRAI {
+namespace tbox {
+
+/*!
+ * @brief Class HeapAllocator allocates each request from the general heap
+ * with operator new.
+ *
+ * This is the global default allocator unless another one is set with
+ * SAMRAIManager::setDefaultAllocator().
+ */
+
+class HeapAllocator:public MemoryAllocator
+{
+public:
+   /*!
+    * @brief Constructor.
+    *
+    * @param[in] name  Name used when reporting memory usage.
+    */
+   explicit HeapAllocator(
+      const std::string& name = "heap");
+
+   /*!
+    * @brief Destructor.
+    */
+   virtual ~HeapAllocator();
+
+   /*!
+    * @brief Return the alignment of memory returned by operator new.
+    */
+   virtual size_t
+   getAlignment() const;
+
+protected:
+   virtual void *
+   allocateBytes(
+      size_t bytes);
+
+   virtual void
+   deallocateBytes(
+      void* ptr,
+      size_t bytes);
+
+private:
+   HeapAllocator(
+      const HeapAllocator&);                // not implemented
+   HeapAllocator&
+   operator = (
+      const HeapAllocator&);                // not implemented
+};
+
+}
+}
+
+#endif
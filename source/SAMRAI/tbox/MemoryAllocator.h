@@ -0,0 +1,263 @@
+/*************************************************************************
+ *
+ * This file is part of the SAMRAI distribution.  For full copyright
+ * information, see COPYRIGHT and LICENSE.
+ *
+ * Copyright:     (c) 1997-2017 Lawrence Livermore National Security, LLC
+ * Description:   Abstract base class for allocators of array storage
+ *
+ ************************************************************************/
+
+#ifndef included_tbox_MemoryAllocator
+#define included_tbox_MemoryAllocator
+
+#include "SAMRAI/SAMRAI_config.h"
+
+#include "SAMRAI/tbox/OpenMPUtilities.h"
+
+#include <memory>
+#include <string>
+
+namespace SAMRAI {
+namespace tbox {
+
+/*!
+ * @brief Class MemoryAllocator is the abstract base class for allocators
+ * that provide the storage of array-based patch data (pdat::ArrayData).
+ *
+ * Concrete allocators implement allocateBytes() and deallocateBytes().
+ * The base class keeps track of the number of bytes in use and its
+ * high-water mark, serializes calls from multiple threads, and registers
+ * each allocator with MemoryUtilities so its usage can be reported with
+ * MemoryUtilities::printAllocatorMemory().
+ *
+ * An allocator also carries a flag telling clients whether the storage
+ * they obtain from it must be initialized.  By default it is, matching
+ * the value-initialization of a std::vector.  When the flag is turned
+ * off, arrays of built-in types are left uninitialized, which avoids
+ * touching the memory twice for data that is filled right away.
+ *
+ * The allocator used for new arrays is selected as follows:
+ *
+ * -# The allocator of the patch data component, set with
+ *    hier::PatchDescriptor::setComponentAllocator().
+ * -# The allocator of the patch level, when allocating through
+ *    hier::PatchLevel.  See hier::PatchLevel::setAllocator() and
+ *    SAMRAIManager::setLevelArenaChunkBytes().
+ * -# The global default, SAMRAIManager::getDefaultAllocator().
+ *
+ * The first two are put in effect with a MemoryAllocator::Scope object
+ * while the patch data is created, and getCurrent() returns the
+ * allocator of the innermost scope.  Clients hold a shared pointer to
+ * the allocator that provided their storage, so an allocator lives at
+ * least as long as the memory it handed out.
+ *
+ * @see HeapAllocator
+ * @see AlignedAllocator
+ * @see ArenaAllocator
+ */
+
+class MemoryAllocator
+{
+public:
+   /*!
+    * @brief Put an allocator in effect for the lifetime of the Scope.
+    *
+    * Scopes nest; the previously current allocator is restored when the
+    * Scope is destroyed.  A null allocator leaves the current allocator
+    * unchanged.  Scopes must only be created outside of threaded regions.
+    */
+   class Scope
+   {
+public:
+      explicit Scope(
+         const std::shared_ptr<MemoryAllocator>& allocator);
+
+      ~Scope();
+
+private:
+      Scope(
+         const Scope&);                // not implemented
+      Scope&
+      operator = (
+         const Scope&);                // not implemented
+
+      std::shared_ptr<MemoryAllocator> d_previous;
+      bool d_active;
+   };
+
+   /*!
+    * @brief Construct an allocator with the given name and register it
+    * with MemoryUtilities.
+    *
+    * @param[in] name  Name used when reporting memory usage.
+    */
+   explicit MemoryAllocator(
+      const std::string& name);
+
+   /*!
+    * @brief The destructor unregisters the allocator from MemoryUtilities.
+    */
+   virtual ~MemoryAllocator();
+
+   /*!
+    * @brief Allocate the given number of bytes.
+    *
+    * @param[in] bytes
+    *
+    * @return Pointer to the storage, or 0 if bytes is zero.
+    */
+   void *
+   allocate(
+      size_t bytes);
+
+   /*!
+    * @brief Release storage obtained from allocate().
+    *
+    * @param[in] ptr    Pointer returned by allocate().
+    * @param[in] bytes  Number of bytes passed to allocate().
+    */
+   void
+   deallocate(
+      void* ptr,
+      size_t bytes);
+
+   /*!
+    * @brief Return the alignment in bytes guaranteed for the storage
+    * returned by allocate().
+    */
+   virtual size_t
+   getAlignment() const = 0;
+
+   /*!
+    * @brief Return the number of bytes reserved from the system.
+    *
+    * The default implementation returns getBytesInUse().  Allocators that
+    * hold on to memory, such as ArenaAllocator, return the size of the
+    * memory they hold.
+    */
+   virtual size_t
+   getBytesReserved() const;
+
+   /*!
+    * @brief Return the largest number of bytes reserved from the system
+    * at any time.
+    */
+   virtual size_t
+   getMaxBytesReserved() const;
+
+   /*!
+    * @brief Return the name of the allocator.
+    */
+   const std::string&
+   getName() const
+   {
+      return d_name;
+   }
+
+   /*!
+    * @brief Return the number of bytes handed out and not yet released.
+    */
+   size_t
+   getBytesInUse() const
+   {
+      return d_bytes_in_use;
+   }
+
+   /*!
+    * @brief Return the high-water mark of getBytesInUse().
+    */
+   size_t
+   getMaxBytesInUse() const
+   {
+      return d_max_bytes_in_use;
+   }
+
+   /*!
+    * @brief Return the number of allocations not yet released.
+    */
+   size_t
+   getNumberOfAllocations() const
+   {
+      return d_num_allocations;
+   }
+
+   /*!
+    * @brief Set whether clients must initialize the storage they obtain
+    * from this allocator.
+    *
+    * @param[in] initialize_memory
+    */
+   void
+   setInitializeMemory(
+      bool initialize_memory)
+   {
+      d_initialize_memory = initialize_memory;
+   }
+
+   /*!
+    * @brief Return whether clients must initialize the storage they
+    * obtain from this allocator.
+    */
+   bool
+   getInitializeMemory() const
+   {
+      return d_initialize_memory;
+   }
+
+   /*!
+    * @brief Return the allocator that new arrays should use.
+    *
+    * This is the allocator of the innermost Scope, or the global default
+    * if no Scope is in effect.
+    */
+   static const std::shared_ptr<MemoryAllocator>&
+   getCurrent();
+
+protected:
+   /*!
+    * @brief Allocate storage for the given non-zero number of bytes.
+    *
+    * Calls are serialized by the base class.
+    */
+   virtual void *
+   allocateBytes(
+      size_t bytes) = 0;
+
+   /*!
+    * @brief Release storage obtained from allocateBytes().
+    *
+    * Calls are serialized by the base class.
+    */
+   virtual void
+   deallocateBytes(
+      void* ptr,
+      size_t bytes) = 0;
+
+private:
+   MemoryAllocator(
+      const MemoryAllocator&);                // not implemented
+   MemoryAllocator&
+   operator = (
+      const MemoryAllocator&);                // not implemented
+
+   std::string d_name;
+
+   size_t d_bytes_in_use;
+   size_t d_max_bytes_in_use;
+   size_t d_num_allocations;
+
+   bool d_initialize_memory;
+
+   TBOX_omp_lock_t l_allocate;
+
+   /*
+    * Allocator of the innermost Scope, or null.
+    */
+   static std::shared_ptr<MemoryAllocator> s_current;
+};
+
+}
+}
+
+#endif
@@ -16,10 +16,15 @@
 #ifndef included_iostream
 #include <iostream>
 #endif
+#include <map>
+#include <string>
+#include <vector>
 
 namespace SAMRAI {
 namespace tbox {
 
+class MemoryAllocator;
+
 /*!
  * @brief Class MemoryUtilities provides utility methods for memory usage and
  * misc memory utilities.
@@ -39,6 +44,9 @@ namespace tbox {
  * profile of the recorded memory information so that it can be analyzed
  * via a post-processing tool.
  *
+ * Memory obtained through MemoryAllocator objects is reported per
+ * allocator by "printAllocatorMemory()".
+ *
  * Note that all member functions of this class are static so it is not
  * necessary to instantiate the class.  Simply call the functions as
  * static functions; e.g.,MemoryUtilities::function(...).
@@ -69,6 +77,46 @@ struct MemoryUtilities {
    printMaxMemory(
       std::ostream& os);
 
+   /*!
+    * @brief Print the memory held by each MemoryAllocator to the supplied
+    * output stream.
+    *
+    * For each allocator name, the bytes in use, the bytes reserved from
+    * the system and the high-water mark of the reserved bytes are printed.
+    * The high-water mark of a name covers all allocators that had the
+    * name, including those already destroyed, so the arena of a patch
+    * level is reported across regrids.  Only the local process is reported.
+    */
+   static void
+   printAllocatorMemory(
+      std::ostream& os);
+
+   /*!
+    * @brief Return the high-water mark of the bytes reserved by
+    * allocators with the given name, or zero if there were none.
+    */
+   static size_t
+   getAllocatorMaxBytesReserved(
+      const std::string& name);
+
+   /*!
+    * @brief Register an allocator for printAllocatorMemory().
+    *
+    * Called by the MemoryAllocator constructor.
+    */
+   static void
+   registerAllocator(
+      const MemoryAllocator* allocator);
+
+   /*!
+    * @brief Unregister an allocator, keeping its high-water mark.
+    *
+    * Called by the MemoryAllocator destructor.
+    */
+   static void
+   unregisterAllocator(
+      const MemoryAllocator* allocator);
+
    /**
     * Static function to compute alignment for memory allocation.
     * Data allocations less than the alignment size are rounded up to
@@ -87,6 +135,19 @@ private:
     */
    static double s_max_memory;
 
+   /*
+    * Live allocators and the high-water mark of reserved bytes by
+    * allocator name.  Held in a function-local static so that it
+    * outlives allocators with static storage duration.
+    */
+   struct AllocatorRegistry {
+      std::vector<const MemoryAllocator *> d_allocators;
+      std::map<std::string, size_t> d_max_bytes_reserved;
+   };
+
+   static AllocatorRegistry&
+   getAllocatorRegistry();
+
    enum { ArenaAllocationAlignment = 16 };
 };
 
@@ -72,6 +72,23 @@ public:
       const void* data_to_read = 0,
       bool deep_copy = true);
 
+   /*!
+    * @brief Create a Write-mode message stream that writes in place
+    * into an externally owned buffer.
+    *
+    * This lets several streams pack into disjoint parts of one message
+    * buffer without copying.  The buffer is not grown and must stay
+    * valid while the stream is used.
+    *
+    * @param[in] num_bytes      Number of bytes in the buffer.
+    * @param[in] data_to_write  Buffer to write into.
+    *
+    * @pre num_bytes == 0 || data_to_write != 0
+    */
+   MessageStream(
+      const size_t num_bytes,
+      void* data_to_write);
+
    /*!
     * @brief Default constructor creates a message stream with a
     * buffer that automatically grows as needed, for writing.
@@ -112,8 +129,10 @@ public:
    {
       if (d_mode == Read) {
          return static_cast<const void *>(d_read_buffer);
+      } else if (d_write_target) {
+         return static_cast<const void *>(d_write_target);
       } else {
-         return &d_write_buffer[0];
+         return static_cast<const void *>(d_write_buffer);
       }
    }
 
@@ -126,11 +145,27 @@ public:
       return d_buffer_index;
    }
 
+   /*!
+    * @brief Empty a Write-mode stream so it can be written again,
+    * keeping the buffer already allocated.
+    *
+    * This lets a stream be reused for a series of messages without
+    * reallocating its buffer each time.
+    *
+    * @param[in] num_bytes  Number of bytes to reserve in the stream.
+    *
+    * @pre writeMode()
+    */
+   void
+   reset(
+      const size_t num_bytes);
+
    /*!
     * @brief Tell a Write-mode stream to allocate more buffer
     * as needed for data.
     *
-    * It is an error to use this method for a Read-mode stream.
+    * It is an error to use this method for a Read-mode stream or a
+    * stream writing into an external buffer.
     *
     * @pre writeMode()
     */
@@ -138,6 +173,7 @@ public:
    growBufferAsNeeded()
    {
       TBOX_ASSERT(writeMode());
+      TBOX_ASSERT(d_write_target == 0);
       d_grow_as_needed = true;
    }
 
@@ -255,6 +291,97 @@ public:
       }
    }
 
+   /*!
+    * @brief Whether the current stream position is suitably aligned
+    * for direct access to items of type DATA_TYPE.
+    *
+    * Callers wanting to read or write the stream buffer in place
+    * through getPackPointer() or getUnpackPointer() must check this
+    * first and fall back to pack() or unpack() if it returns false.
+    */
+   template<typename DATA_TYPE>
+   bool
+   isCursorAligned() const
+   {
+      if (d_mode == Read) {
+         return reinterpret_cast<size_t>(d_read_buffer + d_buffer_index)
+                % alignof(DATA_TYPE) == 0;
+      }
+      if (d_write_target) {
+         return reinterpret_cast<size_t>(d_write_target + d_buffer_index)
+                % alignof(DATA_TYPE) == 0;
+      }
+      /*
+       * The write buffer is allocated by operator new[], which aligns
+       * for all fundamental types, so only the offset matters.
+       */
+      return d_buffer_index % alignof(DATA_TYPE) == 0;
+   }
+
+   /*!
+    * @brief Reserve space for num_items of type DATA_TYPE in the
+    * stream and return a pointer to it, advancing the stream pointer.
+    *
+    * This lets a caller pack data directly into the message buffer
+    * instead of staging it in a temporary array and copying it in with
+    * pack().  The returned pointer is valid only until the next
+    * operation that writes to the stream.
+    *
+    * @param[in] num_items
+    *
+    * @pre writeMode()
+    * @pre isCursorAligned<DATA_TYPE>()
+    * @pre growAsNeeded() || canCopyIn(getSizeof<DATA_TYPE>(num_items))
+    */
+   template<typename DATA_TYPE>
+   DATA_TYPE *
+   getPackPointer(
+      size_t num_items)
+   {
+      TBOX_ASSERT(writeMode());
+      TBOX_ASSERT(isCursorAligned<DATA_TYPE>());
+      const size_t nbytes = MessageStream::getSizeof<DATA_TYPE>(num_items);
+      if (!growAsNeeded()) {
+         TBOX_ASSERT(canCopyIn(nbytes));
+      }
+      const size_t offset = d_buffer_index;
+      d_buffer_index += nbytes;
+      if (d_write_target) {
+         d_buffer_size = d_buffer_index;
+         return reinterpret_cast<DATA_TYPE *>(d_write_target + offset);
+      }
+      reserveWriteBuffer(d_buffer_index);
+      d_buffer_size = d_buffer_index;
+      return reinterpret_cast<DATA_TYPE *>(d_write_buffer + offset);
+   }
+
+   /*!
+    * @brief Return a pointer to the next num_items of type DATA_TYPE
+    * in the stream, advancing the stream pointer.
+    *
+    * This lets a caller unpack data directly from the message buffer
+    * instead of copying it out with unpack() first.
+    *
+    * @param[in] num_items
+    *
+    * @pre readMode()
+    * @pre isCursorAligned<DATA_TYPE>()
+    * @pre canCopyOut(getSizeof<DATA_TYPE>(num_items))
+    */
+   template<typename DATA_TYPE>
+   const DATA_TYPE *
+   getUnpackPointer(
+      size_t num_items)
+   {
+      TBOX_ASSERT(readMode());
+      TBOX_ASSERT(isCursorAligned<DATA_TYPE>());
+      const size_t nbytes = MessageStream::getSizeof<DATA_TYPE>(num_items);
+      TBOX_ASSERT(canCopyOut(nbytes));
+      const char* data = d_read_buffer + d_buffer_index;
+      d_buffer_index += nbytes;
+      return reinterpret_cast<const DATA_TYPE *>(data);
+   }
+
    /*!
     * @brief Print out internal object data.
     *
@@ -298,7 +425,8 @@ public:
    canCopyIn(
       size_t num_bytes) const
    {
-      return d_buffer_index + num_bytes <= d_write_buffer.capacity();
+      return d_buffer_index + num_bytes <=
+             (d_write_target ? d_write_capacity : d_write_buffer_capacity);
    }
 
    /*!
@@ -327,15 +455,41 @@ private:
       if (!growAsNeeded()) {
          TBOX_ASSERT(canCopyIn(num_bytes));
       }
-      if (num_bytes > 0) {
-         d_write_buffer.insert(d_write_buffer.end(),
-            static_cast<const char *>(input_data),
-            static_cast<const char *>(input_data) + num_bytes);
-         d_buffer_size = d_write_buffer.size();
+      if (num_bytes > 0 && d_write_target) {
+         memcpy(d_write_target + d_buffer_index, input_data, num_bytes);
          d_buffer_index += num_bytes;
+         d_buffer_size = d_buffer_index;
+      } else if (num_bytes > 0) {
+         reserveWriteBuffer(d_buffer_index + num_bytes);
+         memcpy(d_write_buffer + d_buffer_index, input_data, num_bytes);
+         d_buffer_index += num_bytes;
+         d_buffer_size = d_buffer_index;
+      }
+   }
+
+   /*!
+    * @brief Make the write buffer hold at least num_bytes, keeping the
+    * bytes already written.
+    */
+   void
+   reserveWriteBuffer(
+      const size_t num_bytes)
+   {
+      if (num_bytes > d_write_buffer_capacity) {
+         growWriteBuffer(num_bytes);
       }
    }
 
+   /*!
+    * @brief Reallocate the write buffer to hold at least num_bytes.
+    *
+    * The capacity is at least doubled so a stream growing as needed is
+    * reallocated a logarithmic number of times.
+    */
+   void
+   growWriteBuffer(
+      const size_t num_bytes);
+
    /*!
     * @brief Copy data out of the stream, advancing the stream pointer.
     *
@@ -365,9 +519,13 @@ private:
    const StreamMode d_mode;
 
    /*!
-    * The buffer for the streamed data to be written.
+    * The buffer for the streamed data to be written and its allocated
+    * size.  It is not a std::vector because resizing one would zero
+    * the bytes that getPackPointer() hands out to be overwritten.
+    * Bytes past d_buffer_size are uninitialized.
     */
-   std::vector<char> d_write_buffer;
+   char* d_write_buffer;
+   size_t d_write_buffer_capacity;
 
    /*!
     * @brief Pointer to the externally supplied memory to read from in
@@ -376,10 +534,18 @@ private:
     */
    const char* d_read_buffer;
 
+   /*!
+    * @brief External buffer written in place by a stream created with
+    * the constructor taking data_to_write, and its size.  The target is
+    * null when writing into d_write_buffer.
+    */
+   char* d_write_target;
+   size_t d_write_capacity;
+
    /*!
     * @brief Number of bytes in the buffer.
     *
-    * Equal to d_write_buffer.size() in write mode, size of supplied external
+    * Number of bytes written in write mode, size of supplied external
     * buffer size in read mode.
     */
    size_t d_buffer_size;
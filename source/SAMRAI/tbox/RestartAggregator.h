@@ -0,0 +1,176 @@
+/*************************************************************************
+ *
+ * This file is part of the SAMRAI distribution.  For full copyright
+ * information, see COPYRIGHT and LICENSE.
+ *
+ * Copyright:     (c) 1997-2017 Lawrence Livermore National Security, LLC
+ * Description:   Restart files shared by groups of processes
+ *
+ ************************************************************************/
+
+#ifndef included_tbox_RestartAggregator
+#define included_tbox_RestartAggregator
+
+#include "SAMRAI/SAMRAI_config.h"
+
+#include "SAMRAI/tbox/Database.h"
+#include "SAMRAI/tbox/SAMRAI_MPI.h"
+
+#include <string>
+#include <memory>
+#include <vector>
+
+namespace SAMRAI {
+namespace tbox {
+
+/*!
+ * @brief Write restart data to a few files shared by groups of
+ * processes, and read it back on any number of processes.
+ *
+ * Writing is collective.  Each process serializes its restart database
+ * and sends it to the first process of its group.  That process appends
+ * the data of the group to one file.  There are num_files groups of
+ * consecutive ranks.  Process 0 writes an index giving the file, offset
+ * and length of each process's data.  The directory layout is
+ *
+ * @code
+ *   dirname/
+ *     index
+ *     file.[file number]
+ * @endcode
+ *
+ * Reading is collective too.  Process 0 reads the index and broadcasts
+ * it.  When the number of processes equals the number that wrote the
+ * files, each process reads back its own database.  Otherwise, the
+ * writing ranks are split into consecutive blocks, one per reading rank,
+ * and each reading rank merges the databases of its block.  A reading
+ * rank with an empty block keeps only the global data of one writer.
+ * Merging follows the restart layout of hier::PatchLevel, hier::BoxLevel
+ * and hier::Patch, the same conventions the restart-redistribute tool
+ * relies on:
+ * - Patches and boxes of all merged ranks are kept.  Their LocalIds are
+ *   offset so they stay unique, and their owner becomes the reading rank.
+ * - Everything else is taken from the first merged rank.
+ *
+ * The files hold native binary data, so they are not portable between
+ * machines of different byte order.
+ */
+class RestartAggregator
+{
+public:
+   /*!
+    * @brief Write the restart database of each process to shared files.
+    *
+    * @param[in] database Restart data of this process.
+    * @param[in] dirname Directory for the files.  It is created if needed.
+    * @param[in] num_files Number of files.  Limited to the number of
+    * processes.
+    * @param[in] mpi
+    *
+    * @pre num_files > 0
+    */
+   static void
+   writeFiles(
+      Database& database,
+      const std::string& dirname,
+      int num_files,
+      const SAMRAI_MPI& mpi);
+
+   /*!
+    * @brief Return true if dirname holds shared restart files.
+    *
+    * Process 0 looks for the index and broadcasts the answer.
+    */
+   static bool
+   hasFiles(
+      const std::string& dirname,
+      const SAMRAI_MPI& mpi);
+
+   /*!
+    * @brief Read the restart data for this process from shared files.
+    *
+    * @return A MemoryDatabase holding the restart data of this process.
+    */
+   static std::shared_ptr<Database>
+   readFiles(
+      const std::string& dirname,
+      const SAMRAI_MPI& mpi);
+
+private:
+   // Static class: not implemented.
+   RestartAggregator();
+
+   /*
+    * Merge the databases written by several ranks into one for
+    * new_rank.  If keep_local is false, only one input is given and its
+    * patches and boxes are dropped.
+    */
+   static void
+   mergeDatabases(
+      const std::vector<std::shared_ptr<Database> >& inputs,
+      Database& output,
+      bool keep_local,
+      int new_rank,
+      int new_nprocs);
+
+   /*
+    * Merge the databases of a patch level.
+    */
+   static void
+   mergePatchLevels(
+      const std::vector<std::shared_ptr<Database> >& inputs,
+      Database& output,
+      bool keep_local,
+      int new_rank,
+      int new_nprocs);
+
+   /*
+    * Merge the databases of a box level.  The LocalIds of input i are
+    * increased by local_id_offsets[i].
+    */
+   static void
+   mergeBoxLevels(
+      const std::vector<std::shared_ptr<Database> >& inputs,
+      const std::vector<int>& local_id_offsets,
+      Database& output,
+      bool keep_local,
+      int new_rank,
+      int new_nprocs);
+
+   /*
+    * Compute the LocalId offset for each of the box level databases
+    * being merged.  An input's LocalIds are shifted only as far as
+    * needed to follow those of the previous input, so globally unique
+    * (e.g. sequentialized) LocalIds are kept as they are.
+    */
+   static void
+   computeLocalIdOffsets(
+      const std::vector<std::shared_ptr<Database> >& box_levels,
+      std::vector<int>& local_id_offsets);
+
+   /*
+    * Returns the directory's index and file names.
+    */
+   static std::string
+   getIndexName(
+      const std::string& dirname);
+   static std::string
+   getFileName(
+      const std::string& dirname,
+      int file_number);
+
+   /*
+    * Tag for messages carrying serialized databases.
+    */
+   static const int s_tag = 1;
+
+   /*
+    * Largest message sent at once, in bytes.
+    */
+   static const size_t s_max_message_bytes;
+};
+
+}
+}
+
+#endif
@@ -16,10 +16,13 @@
 #include "SAMRAI/tbox/Serializable.h"
 #include "SAMRAI/tbox/Database.h"
 #include "SAMRAI/tbox/DatabaseFactory.h"
+#include "SAMRAI/tbox/StartupShutdownManager.h"
+#include "SAMRAI/tbox/Timer.h"
 
 #include <string>
 #include <list>
 #include <memory>
+#include <future>
 
 namespace SAMRAI {
 namespace tbox {
@@ -73,6 +76,30 @@ namespace tbox {
  * both a restart directory name and a restore number for its arguments.
  * See comments for member functions for more details.
  *
+ * Restart files may be written asynchronously (see setAsynchronousWrite()).
+ * writeRestartFile() then has the registered objects write into an
+ * in-memory snapshot (a MemoryDatabase), starts a background thread that
+ * copies the snapshot into the restart file, and returns.  The simulation
+ * stalls only while the snapshot is taken.  At most one write is pending
+ * at a time; a new write, openRestartFile() and program shutdown first
+ * wait for the pending one.  The background thread uses HDF5 while the
+ * application may use it too, so writing HDF5 restart files in the
+ * background requires an HDF5 library built thread-safe
+ * (H5_HAVE_THREADSAFE); writeRestartFile() reports an error otherwise.
+ * With a limit on the snapshot
+ * size (see setAsynchronousWrite()), a write whose previous restart data
+ * exceeded the limit skips the snapshot and writes the file directly.
+ * The time spent in writeRestartFile() on the calling thread is recorded
+ * by the timer "tbox::RestartManager::writeRestartFile".
+ *
+ * Restart data may also be written to a few files shared by groups of
+ * processes instead of one file per process (see setAggregatedWrite()).
+ * Such files are written to restore.[restore number]/aggregated/ under
+ * the restart directory and may be read back by any number of processes;
+ * openRestartFile() uses them whenever they exist for the restore number.
+ * See RestartAggregator.  Aggregated writes do not use the database
+ * factory and are never asynchronous.
+ *
  * @see Database
  */
 
@@ -106,6 +133,10 @@ public:
     * Attempts to mount, for reading, the restart file for the processor.
     * If there is no error opening the file, then the restart manager
     * mounts the restart file.
+    *
+    * If the restore number was written to aggregated files, they are
+    * read instead and num_nodes is ignored: the data is redistributed
+    * over the current processes.
     * Returns true if open is successful; false otherwise.
     *
     * @pre hasDatabaseFactory()
@@ -244,6 +275,79 @@ public:
    void
    writeRestartToDatabase();
 
+   /*!
+    * @brief Set whether writeRestartFile() writes the file on a
+    * background thread.
+    *
+    * With the HDFDatabaseFactory, this requires an HDF5 library built
+    * thread-safe.
+    *
+    * @param[in] async_write
+    * @param[in] max_snapshot_bytes Largest snapshot, in bytes, that may
+    * be held while its file is written in the background.  Zero means no
+    * limit.  Otherwise a snapshot is taken only if the restart data of
+    * the previous write fit in the limit; the first write, and any
+    * write following one that exceeded the limit, goes directly to the
+    * file.  A snapshot that still turns out larger than the limit is
+    * written before writeRestartFile() returns.
+    */
+   void
+   setAsynchronousWrite(
+      bool async_write,
+      size_t max_snapshot_bytes = 0)
+   {
+      d_async_write = async_write;
+      d_max_snapshot_bytes = max_snapshot_bytes;
+   }
+
+   /*!
+    * @brief Returns true if restart files are written on a background
+    * thread.
+    */
+   bool
+   isAsynchronousWrite() const
+   {
+      return d_async_write;
+   }
+
+   /*!
+    * @brief Set the number of files shared by all processes that
+    * writeRestartFile() writes, or 0 for one file per process.
+    *
+    * @pre num_files >= 0
+    */
+   void
+   setAggregatedWrite(
+      int num_files)
+   {
+      TBOX_ASSERT(num_files >= 0);
+      d_num_aggregated_files = num_files;
+   }
+
+   /*!
+    * @brief Returns the number of shared files writeRestartFile()
+    * writes, or 0 if it writes one file per process.
+    */
+   int
+   getNumberOfAggregatedFiles() const
+   {
+      return d_num_aggregated_files;
+   }
+
+   /*!
+    * @brief Returns true if a restart file is still being written in
+    * the background.
+    */
+   bool
+   isRestartWritePending() const;
+
+   /*!
+    * @brief Block until any restart file being written in the
+    * background is complete.
+    */
+   void
+   waitForRestartWrite();
+
 protected:
    /**
     * The constructor for RestartManager is protected.
@@ -306,6 +410,30 @@ private:
       const std::string& root_dirname,
       int restore_num);
 
+   /*
+    * Name of the directory holding aggregated files for a restore number.
+    */
+   std::string
+   getAggregatedDirname(
+      const std::string& root_dirname,
+      int restore_num) const;
+
+   /*
+    * Approximate number of bytes of data held in a database, recursively.
+    */
+   static size_t
+   getDatabaseBytes(
+      Database& database);
+
+   /*
+    * Copy a snapshot into a restart file and close the file.  This runs
+    * on the background thread of an asynchronous write.
+    */
+   static void
+   writeSnapshot(
+      std::shared_ptr<Database> snapshot,
+      std::shared_ptr<Database> restart_db);
+
    struct RestartItem {
       std::string name;
       Serializable* obj;
@@ -319,6 +447,18 @@ private:
    static void
    shutdownCallback();
 
+   /*!
+    * @brief Set up the timers.
+    */
+   static void
+   initializeCallback();
+
+   /*!
+    * @brief Release the timers.
+    */
+   static void
+   finalizeCallback();
+
    static RestartManager* s_manager_instance;
 
    /*
@@ -336,7 +476,35 @@ private:
 
    bool d_is_from_restart;
 
+   /*
+    * Whether writeRestartFile() writes on a background thread, and the
+    * largest snapshot allowed to be held for such a write.
+    */
+   bool d_async_write;
+   size_t d_max_snapshot_bytes;
+
+   /*
+    * Approximate size of the restart data last written in asynchronous
+    * mode, or zero if not known.  It decides whether the next write may
+    * take a snapshot under d_max_snapshot_bytes.
+    */
+   size_t d_restart_bytes;
+
+   /*
+    * Completion of the restart file being written in the background.
+    */
+   std::future<void> d_pending_write;
+
+   /*
+    * Number of files shared by all processes, or 0 for one file per
+    * process.
+    */
+   int d_num_aggregated_files;
+
+   static std::shared_ptr<Timer> t_write_restart;
+
    static StartupShutdownManager::Handler s_shutdown_handler;
+   static StartupShutdownManager::Handler s_initialize_finalize_handler;
 };
 
 }
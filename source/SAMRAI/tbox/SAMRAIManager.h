@@ -14,8 +14,11 @@
 #include "SAMRAI/SAMRAI_config.h"
 
 #include "SAMRAI/tbox/Database.h"
+#include "SAMRAI/tbox/MemoryAllocator.h"
 #include "SAMRAI/tbox/SAMRAI_MPI.h"
 
+#include <memory>
+
 namespace SAMRAI {
 namespace tbox {
 
@@ -48,7 +51,9 @@ namespace tbox {
  * run.
  *
  * Additionally this class manages static data that controls the maximum
- * number of patch data components that can be allowed.
+ * number of patch data components that can be allowed, and the memory
+ * allocators used for array-based patch data:  the global default
+ * allocator and the chunk size of the arenas created for patch levels.
  *
  * @see SAMRAI_MPI
  * @see StartupShutdownManager
@@ -138,6 +143,7 @@ public:
    {
       TBOX_ASSERT(s_initialized);
       StartupShutdownManager::finalize();
+      s_default_allocator.reset();
       PIO::finalize();
       s_initialized = false;
    }
@@ -182,6 +188,59 @@ public:
    setMaxNumberPatchDataEntries(
       int maxnum);
 
+   /*!
+    * @brief Return the global default allocator for array-based patch data.
+    *
+    * Unless set with setDefaultAllocator(), this is a HeapAllocator
+    * created on first use.
+    */
+   static const std::shared_ptr<MemoryAllocator>&
+   getDefaultAllocator();
+
+   /*!
+    * @brief Set the global default allocator for array-based patch data.
+    *
+    * Data allocated afterwards uses the new allocator unless its patch
+    * data component or patch level selects another one.  Existing data
+    * keeps the allocator it was created with.  A null pointer restores
+    * the default HeapAllocator.
+    *
+    * @param[in] allocator
+    */
+   static void
+   setDefaultAllocator(
+      const std::shared_ptr<MemoryAllocator>& allocator)
+   {
+      s_default_allocator = allocator;
+   }
+
+   /*!
+    * @brief Return the chunk size of the arenas created for patch levels,
+    * or zero if patch levels do not get arenas.
+    */
+   static size_t
+   getLevelArenaChunkBytes()
+   {
+      return s_level_arena_chunk_bytes;
+   }
+
+   /*!
+    * @brief Set the chunk size of the arenas created for patch levels.
+    *
+    * When non-zero, each hier::PatchLevel without an allocator of its own
+    * creates an ArenaAllocator with chunks of the given size the first
+    * time it allocates patch data, and allocates the data of all its
+    * patches from it.  Zero, the default, turns level arenas off.
+    *
+    * @param[in] chunk_bytes
+    */
+   static void
+   setLevelArenaChunkBytes(
+      size_t chunk_bytes)
+   {
+      s_level_arena_chunk_bytes = chunk_bytes;
+   }
+
 private:
    // Unimplemented default constructor.
    SAMRAIManager();
@@ -210,6 +269,16 @@ private:
     */
    static int s_max_patch_data_entries;
 
+   /*!
+    * Global default allocator for array-based patch data.
+    */
+   static std::shared_ptr<MemoryAllocator> s_default_allocator;
+
+   /*!
+    * Chunk size of patch level arenas; zero if levels have no arenas.
+    */
+   static size_t s_level_arena_chunk_bytes;
+
 
 };
 
@@ -405,6 +405,10 @@ public:
    Request_free(
       Request* request);
 
+   static int
+   Start(
+      Request* request);
+
    static int
    Test(
       Request* request,
@@ -498,6 +502,26 @@ public:
       Datatype datatype,
       Op op) const;
 
+   int
+   Alltoall(
+      void* sendbuf,
+      int sendcount,
+      Datatype sendtype,
+      void* recvbuf,
+      int recvcount,
+      Datatype recvtype) const;
+
+   int
+   Alltoallv(
+      void* sendbuf,
+      int* sendcounts,
+      int* sdispls,
+      Datatype sendtype,
+      void* recvbuf,
+      int* recvcounts,
+      int* rdispls,
+      Datatype recvtype) const;
+
    int
    Attr_get(
       int keyval,
@@ -584,6 +608,24 @@ public:
       int tag,
       Request* request) const;
 
+   int
+   Send_init(
+      void* buf,
+      int count,
+      Datatype datatype,
+      int dest,
+      int tag,
+      Request* request) const;
+
+   int
+   Recv_init(
+      void* buf,
+      int count,
+      Datatype datatype,
+      int source,
+      int tag,
+      Request* request) const;
+
    int
    Probe(
       int source,
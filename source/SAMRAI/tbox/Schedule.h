@@ -22,6 +22,7 @@
 #include <map>
 #include <list>
 #include <memory>
+#include <vector>
 
 namespace SAMRAI {
 namespace tbox {
@@ -48,6 +49,61 @@ namespace tbox {
  * order of transaction execution matters.  The transactions will be
  * executed in the order in which they appear in the list.
  *
+ * <b> Input Parameters </b>
+ *
+ * <b> Definitions: </b>
+ *    - \b reuse_message_buffers
+ *       Default for setReuseMessageBuffersFlag().
+ *
+ *    - \b use_persistent_requests
+ *       Default for setPersistentRequestsFlag().  Ignored, with a
+ *       warning, unless reuse_message_buffers is also TRUE.
+ *
+ *    - \b threaded_transactions
+ *       Default for setThreadedTransactionsFlag().  Enable it only if
+ *       the packing, unpacking and local copy code of every
+ *       transaction type used by the application is thread-safe; see
+ *       setThreadedTransactionsFlag().
+ *
+ * <b> Details: </b> <br>
+ * <table>
+ *   <tr>
+ *     <th>parameter</th>
+ *     <th>type</th>
+ *     <th>default</th>
+ *     <th>range</th>
+ *     <th>opt/req</th>
+ *     <th>behavior on restart</th>
+ *   </tr>
+ *   <tr>
+ *     <td>reuse_message_buffers</td>
+ *     <td>bool</td>
+ *     <td>FALSE</td>
+ *     <td>TRUE, FALSE</td>
+ *     <td>opt</td>
+ *     <td>Not written to restart.  Value in input db used.</td>
+ *   </tr>
+ *   <tr>
+ *     <td>use_persistent_requests</td>
+ *     <td>bool</td>
+ *     <td>FALSE</td>
+ *     <td>TRUE, FALSE</td>
+ *     <td>opt</td>
+ *     <td>Not written to restart.  Value in input db used.</td>
+ *   </tr>
+ *   <tr>
+ *     <td>threaded_transactions</td>
+ *     <td>bool</td>
+ *     <td>FALSE</td>
+ *     <td>TRUE, FALSE</td>
+ *     <td>opt</td>
+ *     <td>Not written to restart.  Value in input db used.</td>
+ *   </tr>
+ * </table>
+ *
+ * The input parameters are read from the "Schedule" database of the
+ * input file, once, when the first Schedule is constructed.
+ *
  * @see Transaction
  */
 
@@ -65,7 +121,7 @@ public:
     * Note that the schedule can not be deleted during a communication
     * phase; this will result in an assertion being thrown.
     *
-    * @pre !allocatedCommunicationObjects()
+    * @pre !hasPendingCommunication()
     */
    ~Schedule();
 
@@ -137,6 +193,7 @@ public:
    setMPI(
       const SAMRAI_MPI& mpi)
    {
+      deallocateCommunicationObjects();
       d_mpi = mpi;
    }
 
@@ -158,6 +215,7 @@ public:
    {
       TBOX_ASSERT(first_tag >= 0);
       TBOX_ASSERT(second_tag >= 0);
+      deallocateCommunicationObjects();
       d_first_tag = first_tag;
       d_second_tag = second_tag;
    }
@@ -201,6 +259,7 @@ public:
       int first_message_length)
    {
       TBOX_ASSERT(first_message_length > 0);
+      deallocateCommunicationObjects();
       d_first_message_length = static_cast<size_t>(first_message_length);
    }
 
@@ -233,6 +292,21 @@ public:
    void
    finalizeCommunication();
 
+   /*!
+    * @brief Perform the local (on-process) copies of a communication
+    * begun with <TT>beginCommunication()</TT>.
+    *
+    * Local copies are normally done in <TT>finalizeCommunication()</TT>.
+    * Calling this method first makes the locally available data usable
+    * while messages are still in transit.  <TT>finalizeCommunication()</TT>
+    * does not repeat the copies.  Calling this method again repeats them,
+    * overwriting anything written to the destinations in between.
+    *
+    * @pre hasPendingCommunication()
+    */
+   void
+   copyLocalData();
+
    /*!
     * @brief Set whether to unpack messages in a deterministic order.
     *
@@ -248,6 +322,101 @@ public:
       d_unpack_in_deterministic_order = flag;
    }
 
+   /*!
+    * @brief Set whether to keep the communication objects and message
+    * buffers from one execution of the schedule to the next.
+    *
+    * By default, the communication objects and the buffers for
+    * outgoing and incoming messages are allocated at the start of
+    * each execution and released at the end.  A schedule that is
+    * executed many times can keep them instead, so the buffers are
+    * allocated once and only grow when a message does not fit.  They
+    * are released when the schedule is deleted or when its
+    * transactions or MPI parameters change.
+    *
+    * The number of allocations is reported by the access count of the
+    * "*::allocate_buffers" timer.
+    *
+    * @param [in] flag
+    *
+    * @pre !hasPendingCommunication()
+    */
+   void
+   setReuseMessageBuffersFlag(
+      bool flag);
+
+   /*!
+    * @brief Set whether to communicate using persistent MPI requests.
+    *
+    * Persistent requests are set up once with MPI_Send_init and
+    * MPI_Recv_init, then restarted by each execution of the schedule.
+    * A request is set up again only if the length of its message
+    * changes.  Persistent requests are used only while the
+    * communication objects are kept between executions (see
+    * setReuseMessageBuffersFlag()); otherwise the flag has no effect.
+    * Messages that are split into two parts use persistent requests
+    * only for the first part.
+    *
+    * @param [in] flag
+    *
+    * @pre !hasPendingCommunication()
+    */
+   void
+   setPersistentRequestsFlag(
+      bool flag);
+
+   /*!
+    * @brief Set whether to pack, unpack and copy transactions using
+    * OpenMP threads.
+    *
+    * In threaded mode, each outgoing message starts with a header of
+    * the space its transactions reserve, and all outgoing transactions
+    * are packed concurrently, each directly into its part of its
+    * message.  On the receiving side, the header lets the transactions
+    * of a message be unpacked concurrently.  Local copies and unpacks
+    * are grouped by Transaction::getDestinationKey(): groups are
+    * executed concurrently and the transactions within a group in
+    * schedule order, so the results are identical to the serial mode.
+    *
+    * Transaction::packStream(), unpackStream() and copyLocalData() are
+    * then called from several threads at once, for different
+    * transactions.  Everything they call must be safe to run
+    * concurrently: patch data packing and copying, and for refine and
+    * coarsen schedules the refine, coarsen and time interpolation
+    * operators and any user patch strategy code run by the
+    * transactions.  Each may write only the destination data of its
+    * own transaction and must not modify shared state without
+    * synchronization.  Because this extends to user code, the mode is
+    * off by default and should be enabled only for schedules whose
+    * transactions are known to meet the requirement.
+    *
+    * Because the message format differs, this flag must be the same
+    * on all processes executing the schedule.  Without OpenMP, the
+    * threaded mode runs on a single thread.
+    *
+    * @param [in] flag
+    *
+    * @pre !hasPendingCommunication()
+    */
+   void
+   setThreadedTransactionsFlag(
+      bool flag)
+   {
+      TBOX_ASSERT(!hasPendingCommunication());
+      d_threaded_transactions = flag;
+   }
+
+   /*!
+    * @brief Return whether transactions are executed in threaded mode.
+    *
+    * @see setThreadedTransactionsFlag()
+    */
+   bool
+   getThreadedTransactionsFlag() const
+   {
+      return d_threaded_transactions;
+   }
+
    /*!
     * @brief Setup names of timers.
     *
@@ -271,6 +440,9 @@ public:
 
    /*!
     * @brief Returns true if the communication objects have been allocated.
+    *
+    * If message buffers are reused (see setReuseMessageBuffersFlag()),
+    * the communication objects stay allocated between executions.
     */
    bool
    allocatedCommunicationObjects()
@@ -278,6 +450,16 @@ public:
       return d_coms != 0;
    }
 
+   /*!
+    * @brief Returns true if the schedule is between
+    * beginCommunication() and finalizeCommunication().
+    */
+   bool
+   hasPendingCommunication() const
+   {
+      return d_communication_pending;
+   }
+
    /*!
     * @brief Get the name of this object.
     */
@@ -293,10 +475,14 @@ private:
    void
    deallocateCommunicationObjects()
    {
+      TBOX_ASSERT(!d_communication_pending);
       if (d_coms) {
          delete[] d_coms;
       }
       d_coms = 0;
+      d_send_streams.clear();
+      d_send_buffers.clear();
+      d_send_sizes.clear();
    }
 
    void
@@ -307,8 +493,79 @@ private:
    performLocalCopies();
    void
    processCompletedCommunications();
+
+   /*!
+    * @brief Unpack a received message into the transactions from a
+    * sender.
+    */
+   void
+   unpackMessage(
+      int sender,
+      const AsyncCommPeer<char>& completed_comm);
+
+   /*!
+    * @brief Pack all outgoing messages in the threaded message format,
+    * packing the transactions concurrently directly into the message
+    * buffers.
+    *
+    * The messages are written into the buffers returned by
+    * getSendBuffer(), which are recorded with the message sizes in
+    * d_send_buffers and d_send_sizes.
+    */
+   void
+   packTransactionsThreaded();
+
+   /*!
+    * @brief Return a buffer to pack outgoing message icom into.
+    *
+    * A message that fits in the first message of its communication
+    * object is packed into the object's own send buffer and sent
+    * without being copied.  A longer message is packed into
+    * d_send_streams[icom] and copied when sent.
+    *
+    * @pre The first data length limit of the communication object has
+    * been set for this execution.
+    */
+   char *
+   getSendBuffer(
+      size_t icom,
+      size_t num_bytes);
+
+   /*!
+    * @brief Unpack a message in the threaded message format, using
+    * threads.
+    */
    void
-   deallocateSendBuffers();
+   unpackThreadedMessage(
+      const std::list<std::shared_ptr<Transaction> >& transactions,
+      const char* message,
+      size_t message_size);
+
+   /*!
+    * @brief Return an upper bound on the bytes the threaded message
+    * format adds to a message of num_transactions transactions.
+    */
+   static size_t
+   getThreadedMessageOverhead(
+      size_t num_transactions)
+   {
+      return num_transactions
+             * (MessageStream::getSizeof<size_t>(1) + s_part_alignment - 1);
+   }
+
+   /*!
+    * @brief Group transactions by destination key for threaded
+    * execution.
+    *
+    * The transactions are copied in order into flat, and each group
+    * holds indices into flat, in increasing order.  If any transaction
+    * has a zero key, all transactions are put in a single group.
+    */
+   static void
+   groupTransactions(
+      const std::list<std::shared_ptr<Transaction> >& transactions,
+      std::vector<Transaction *>& flat,
+      std::vector<std::vector<size_t> >& groups);
 
    Schedule(
       const Schedule&);                 // not implemented
@@ -360,6 +617,17 @@ private:
     * unknown mixed type.
     */
    AsyncCommPeer<char>* d_coms;
+   /*!
+    * @brief Streams for packing outgoing messages, one for each
+    * outgoing message, kept when reusing message buffers.
+    */
+   std::vector<std::shared_ptr<MessageStream> > d_send_streams;
+   /*!
+    * @brief Start and size of each outgoing message of the current
+    * execution, as packed by postSends() or packTransactionsThreaded().
+    */
+   std::vector<char *> d_send_buffers;
+   std::vector<size_t> d_send_sizes;
    /*!
     * @brief Stage for advancing communication operations to
     * completion.
@@ -400,10 +668,51 @@ private:
     */
    bool d_unpack_in_deterministic_order;
 
+   /*!
+    * @brief Whether to keep communication objects and message buffers
+    * between executions.
+    *
+    * @see setReuseMessageBuffersFlag()
+    */
+   bool d_reuse_message_buffers;
+
+   /*!
+    * @brief Whether to use persistent MPI requests.
+    *
+    * @see setPersistentRequestsFlag()
+    */
+   bool d_use_persistent_requests;
+
+   /*!
+    * @brief Whether communication has begun and not been finalized.
+    */
+   bool d_communication_pending;
+
+   /*!
+    * @brief Whether the local copies of the pending communication
+    * have been done.
+    *
+    * @see copyLocalData()
+    */
+   bool d_local_copies_done;
+
+   /*!
+    * @brief Whether to execute transactions in threaded mode.
+    *
+    * @see setThreadedTransactionsFlag()
+    */
+   bool d_threaded_transactions;
+
    static const int s_default_first_tag;
    static const int s_default_second_tag;
    static const size_t s_default_first_message_length;
 
+   /*!
+    * @brief Alignment, in bytes, of each transaction's data within a
+    * message in the threaded message format.
+    */
+   static const size_t s_part_alignment;
+
    //@{
    //! @name Timer data for Schedule class.
 
@@ -426,6 +735,7 @@ private:
       std::shared_ptr<Timer> t_MPI_wait;
       std::shared_ptr<Timer> t_pack_stream;
       std::shared_ptr<Timer> t_unpack_stream;
+      std::shared_ptr<Timer> t_allocate_buffers;
       std::shared_ptr<Timer> t_local_copies;
    };
 
@@ -439,6 +749,15 @@ private:
 
    static char s_ignore_external_timer_prefix;
 
+   /*!
+    * @brief Defaults for d_reuse_message_buffers,
+    * d_use_persistent_requests and d_threaded_transactions, from the
+    * input database.
+    */
+   static bool s_default_reuse_message_buffers;
+   static bool s_default_use_persistent_requests;
+   static bool s_default_threaded_transactions;
+
    /*!
     * @brief Structure of timers in s_static_timers, matching this
     * object's timer prefix.
@@ -416,6 +416,17 @@ private:
     */
    int d_accesses;
 
+   /*
+    * Index of this timer in the per-thread storage of the TimerManager.
+    */
+   int d_thread_slot;
+
+   /*
+    * Whether timers sample the monotonic clock instead of times().
+    * Set by the TimerManager from its timer_clock input.
+    */
+   static bool s_use_monotonic_clock;
+
    static const int DEFAULT_NUMBER_OF_TIMERS_INCREMENT;
 
    /*
@@ -99,6 +99,39 @@ namespace tbox {
  *       the overall run time are not printed.  This can be a convenient
  *       option to limit output if you have many timers invoked.
  *
+ *    - \b    timer_clock
+ *       Clock sampled by timer start and stop calls.  "SYSTEM" reads user
+ *       and system times through times() and wallclock time through
+ *       SAMRAI_MPI::Wtime().  "MONOTONIC" reads only a monotonic wallclock
+ *       through clock_gettime(), which is several times cheaper per call,
+ *       and makes timers safe to start and stop inside OpenMP parallel
+ *       regions.  Each thread other than the master keeps its own times
+ *       and exclusive timer stack, which are summed into the timers by
+ *       mergeThreadTimes() (called by print()).  User and system times
+ *       are not measured with this clock.
+ *
+ *    - \b    trace_events
+ *       Record a timeline of the start and stop calls of active timers
+ *       and write it as Chrome trace event JSON, viewable in
+ *       chrome://tracing or Perfetto.  Each thread records into its own
+ *       ring buffer of trace_buffer_size events, keeping the most recent
+ *       events if it fills.  Timestamps are read from the monotonic
+ *       clock in microseconds from an origin set after a barrier when
+ *       the manager reads its input.  The trace is written by print(),
+ *       or by writeTraceEvents(), to one file per process named
+ *       <TT>trace_file_base.NNNNNNN.json</TT>, in which the process
+ *       number is the trace pid and the thread number the trace tid.
+ *       The files are JSON arrays, so the traces of all processes can be
+ *       merged by concatenating the arrays, e.g. with
+ *       <TT>jq -s add trace_file_base.*.json</TT>.  When disabled,
+ *       timers pay only a flag test.
+ *
+ *    - \b    trace_buffer_size
+ *       Number of trace events kept per thread when trace_events is on.
+ *
+ *    - \b    trace_file_base
+ *       Base name of the trace files written by print().
+ *
  *    - \b    timer_list
  *       List of timers to be invoked.  The timers can be listed individually
  *       in <TT>package::class::method</TT> format or the entries may contain
@@ -212,6 +245,38 @@ namespace tbox {
  *     <td>Not written to restart.  Value in input db used.</td>
  *   </tr>
  *   <tr>
+ *     <td>timer_clock</td>
+ *     <td>string</td>
+ *     <td>"SYSTEM"</td>
+ *     <td>"SYSTEM", "MONOTONIC"</td>
+ *     <td>opt</td>
+ *     <td>Not written to restart.  Value in input db used.</td>
+ *   </tr>
+ *   <tr>
+ *     <td>trace_events</td>
+ *     <td>bool</td>
+ *     <td>FALSE</td>
+ *     <td>TRUE, FALSE</td>
+ *     <td>opt</td>
+ *     <td>Not written to restart.  Value in input db used.</td>
+ *   </tr>
+ *   <tr>
+ *     <td>trace_buffer_size</td>
+ *     <td>int</td>
+ *     <td>65536</td>
+ *     <td>>0</td>
+ *     <td>opt</td>
+ *     <td>Not written to restart.  Value in input db used.</td>
+ *   </tr>
+ *   <tr>
+ *     <td>trace_file_base</td>
+ *     <td>string</td>
+ *     <td>"timer_trace"</td>
+ *     <td>any string</td>
+ *     <td>opt</td>
+ *     <td>Not written to restart.  Value in input db used.</td>
+ *   </tr>
+ *   <tr>
  *     <td>timer_list</td>
  *     <td>array of strings</td>
  *     <td>none</td>
@@ -323,13 +388,55 @@ public:
    void
    resetAllTimers();
 
+   /*!
+    * Sum the times accumulated by threads other than the master into
+    * the timers and clear the per-thread times.
+    *
+    * This is only needed with the "MONOTONIC" timer_clock, and is called
+    * by print().  Call it outside of any parallel region before querying
+    * timers that were used inside one.
+    */
+   void
+   mergeThreadTimes();
+
    /*!
     * Print the timing statistics to the specified output stream.
+    *
+    * If trace_events is on, the trace is also written with
+    * writeTraceEvents() to files named after trace_file_base.
     */
    void
    print(
       std::ostream& os = plog);
 
+   /*!
+    * Return whether start and stop events of active timers are being
+    * recorded (input parameter trace_events).
+    */
+   bool
+   isTracingEvents() const
+   {
+#ifdef ENABLE_SAMRAI_TIMERS
+      return d_trace_events;
+#else
+      return false;
+#endif
+   }
+
+   /*!
+    * Write the recorded timer events of this process as Chrome trace
+    * event JSON to the file file_name_base.NNNNNNN.json, where NNNNNNN
+    * is the process number.  Does nothing if trace_events is off.
+    *
+    * Call this outside of any parallel region.  Events whose start was
+    * dropped from a full buffer are omitted.
+    *
+    * @pre !file_name_base.empty()
+    */
+   void
+   writeTraceEvents(
+      const std::string& file_name_base) const;
+
 protected:
    /*!
     * The constructor for TimerManager is protected.  Consistent
@@ -380,6 +487,36 @@ protected:
    stopTime(
       Timer * timer);
 
+   /*!
+    * Start given timer on a thread other than the master, recording
+    * the time and exclusive timer stack in that thread's own storage.
+    *
+    * @pre timer != 0
+    */
+   void
+   startThreadTime(
+      Timer * timer);
+
+   /*!
+    * Stop given timer on a thread other than the master.
+    *
+    * @pre timer != 0
+    */
+   void
+   stopThreadTime(
+      Timer * timer);
+
+   /*!
+    * Record a trace event with the given Chrome trace phase ('B' for
+    * start, 'E' for stop) for the given timer on the calling thread.
+    *
+    * @pre timer != 0
+    */
+   void
+   recordTraceEvent(
+      const Timer * timer,
+      char phase);
+
 private:
    // Unimplemented default constructor.
    TimerManager();
@@ -554,7 +691,8 @@ private:
       bool active);
 
    /*
-    * Clear the registered timers.
+    * Clear the registered timers.  Thread slots already handed out stay
+    * assigned to their timers.
     */
    void
    clearArrays();
@@ -610,7 +748,78 @@ private:
     * for a timer is its total elapsed time minus any time spent in other
     * timers while that timer is running.
     */
-   std::list<Timer *> d_exclusive_timer_stack;
+   std::vector<Timer *> d_exclusive_timer_stack;
+
+   /*
+    * Times of one timer accumulated by one thread.
+    */
+   struct ThreadTimerData {
+      ThreadTimerData():
+         d_timer(0),
+         d_start_total(0.0),
+         d_start_exclusive(0.0),
+         d_total(0.0),
+         d_exclusive(0.0),
+         d_accesses(0),
+         d_is_running(false) {
+      }
+      Timer* d_timer;
+      double d_start_total;
+      double d_start_exclusive;
+      double d_total;
+      double d_exclusive;
+      int d_accesses;
+      bool d_is_running;
+   };
+
+   /*
+    * A timer start or stop recorded for the event trace.  The slot is
+    * the timer's d_thread_slot and indexes d_trace_names.
+    */
+   struct TraceEvent {
+      double d_time;
+      int d_slot;
+      char d_phase;
+   };
+
+   /*
+    * Per-thread timer storage used by threads other than the master
+    * with the monotonic clock, and by every thread for the event trace.
+    * Data is indexed by Timer::d_thread_slot and the exclusive stack
+    * holds slots.  Each thread only touches its own entry, which is
+    * allocated separately to avoid false sharing.
+    */
+   struct ThreadTimers {
+      ThreadTimers():
+         d_trace_recorded(0) {
+      }
+      std::vector<ThreadTimerData> d_data;
+      std::vector<int> d_exclusive_stack;
+      /*
+       * Ring buffer of trace events and the number of events recorded
+       * into it.  Event i is stored at i % d_trace.size().
+       */
+      std::vector<TraceEvent> d_trace;
+      size_t d_trace_recorded;
+   };
+   std::vector<std::shared_ptr<ThreadTimers> > d_thread_timers;
+
+   /*
+    * Number of thread slots handed out to timers.  Slots are never
+    * reused, even by clearArrays().
+    */
+   int d_num_thread_slots;
+
+   /*
+    * Event trace options and state.  d_trace_names holds the timer
+    * name of each thread slot and d_trace_origin the monotonic time of
+    * trace timestamp zero.
+    */
+   bool d_trace_events;
+   size_t d_trace_buffer_size;
+   std::string d_trace_file_base;
+   double d_trace_origin;
+   std::vector<std::string> d_trace_names;
 
    /*
     * Lists of timer names generated from the input database.  These are
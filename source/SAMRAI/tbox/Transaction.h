@@ -83,6 +83,20 @@ public:
    virtual int
    getDestinationProcessor() = 0;
 
+   /**
+    * Return a key identifying the destination data written by this
+    * transaction's copyLocalData() and unpackStream().
+    *
+    * A threaded Schedule groups transactions by this key.  Groups are
+    * executed concurrently, and transactions within a group are
+    * executed in schedule order.  Transactions with different nonzero
+    * keys must therefore write to disjoint data.  A key of zero means
+    * the destination is unknown, and the Schedule executes all of its
+    * transactions serially.  The default implementation returns zero.
+    */
+   virtual size_t
+   getDestinationKey() const;
+
    /**
     * Pack the transaction data into the message stream.
     */
@@ -125,6 +125,13 @@ public:
    virtual int
    getDestinationProcessor();
 
+   /*!
+    * Return the address of the destination patch, which holds all data
+    * written by this transaction.
+    */
+   virtual size_t
+   getDestinationKey() const;
+
    /*!
     * Pack the transaction data into the message stream.
     */
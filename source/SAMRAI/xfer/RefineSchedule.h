@@ -17,6 +17,7 @@
 #include "SAMRAI/xfer/RefineClasses.h"
 #include "SAMRAI/xfer/RefinePatchStrategy.h"
 #include "SAMRAI/xfer/RefineTransactionFactory.h"
+#include "SAMRAI/xfer/ScratchDataPool.h"
 #include "SAMRAI/xfer/SingularityPatchStrategy.h"
 #include "SAMRAI/hier/ComponentSelector.h"
 #include "SAMRAI/hier/IntVector.h"
@@ -43,6 +44,16 @@ namespace xfer {
  * is copied into the destination space at the end of the process.
  * The communication schedule is executed by calling member function fillData().
  *
+ * The fill may also be split in two phases with beginFillData() and
+ * completeFillData().  beginFillData() fills the coarse levels needed for
+ * interpolation, starts the messages for the destination level and
+ * performs the copies that are local to the process.  completeFillData()
+ * waits for the messages, interpolates from the coarse levels and fills
+ * the physical boundaries.  Between the two calls, the interiors of the
+ * scratch data on the destination level that are copied from local
+ * sources are already valid, so work that does not need ghost data can
+ * overlap the communication.
+ *
  * Each schedule object is typically created by a refine algorithm and
  * represents the communication dependencies for a particular configuration
  * of the AMR hierarchy.  The communication schedule is only valid for that
@@ -62,9 +73,52 @@ namespace xfer {
  * - @c PatchLevelBorderAndInteriorFillPattern - Fill interior and
  *      ghosts on level borders.
  *
+ * The scratch, work and destination data that a fill allocates on its
+ * internal levels are normally deallocated when the fill is done.  A
+ * schedule may instead keep them in a ScratchDataPool so that later
+ * fills reuse the data.  The pool is shared by the schedule and the
+ * schedules it creates for coarser levels, and it is freed with the
+ * schedule or when reset() is called.  At the end of each fill the pool
+ * hit rate and largest size are recorded in the tbox::Statistician as the
+ * processor statistics SDP_HitRate and SDP_BytesRetained, at a sequence
+ * number belonging to the pool, so each schedule has one entry that is
+ * updated in place.
+ *
+ * <b> Input Parameters </b>
+ *
+ * <b> Definitions: </b>
+ *    - \b scratch_pool_max_mbytes
+ *       Maximum size, in megabytes, of the scratch data pool of each
+ *       schedule.  Zero disables the pool.  See also
+ *       setScratchPoolMaxBytes().
+ *
+ * <b> Details: </b> <br>
+ * <table>
+ *   <tr>
+ *     <th>parameter</th>
+ *     <th>type</th>
+ *     <th>default</th>
+ *     <th>range</th>
+ *     <th>opt/req</th>
+ *     <th>behavior on restart</th>
+ *   </tr>
+ *   <tr>
+ *     <td>scratch_pool_max_mbytes</td>
+ *     <td>double</td>
+ *     <td>0.0</td>
+ *     <td>>= 0.0</td>
+ *     <td>opt</td>
+ *     <td>Not written to restart.  Value in input db used.</td>
+ *   </tr>
+ * </table>
+ *
+ * The input parameters are read from the "RefineSchedule" database of the
+ * input file, once, when the first RefineSchedule is constructed.
+ *
  * @see RefineAlgorithm
  * @see RefinePatchStrategy
  * @see RefineClasses
+ * @see ScratchDataPool
  */
 
 class RefineSchedule
@@ -249,6 +303,59 @@ public:
       double fill_time,
       bool do_physical_boundary_fill = true) const;
 
+   /*!
+    * @brief Begin a split-phase fill of the destination level.
+    *
+    * This does all of the work of fillData() that precedes the arrival
+    * of the messages for the destination level:  the scratch space is
+    * allocated, the coarse levels used for interpolation are filled,
+    * the level-to-level messages are posted and the local copies are
+    * done.  It must be followed by completeFillData() before this
+    * schedule is used again.
+    *
+    * Until completeFillData() is called, the scratch data of the
+    * destination level holds what the local copies wrote, which
+    * includes the interior of each destination patch when the source
+    * level is the destination level.  Data from other processes and
+    * interpolated data are missing.  If a refine item reads a scratch
+    * component, the copies that come after interpolation in fillData()
+    * are not done early.
+    *
+    * No other communication using the MPI communicator of this schedule
+    * may be started between beginFillData() and completeFillData(),
+    * because messages are matched by tag.
+    *
+    * @param[in] fill_time                 Time for filling operation.
+    * @param[in] do_physical_boundary_fill See fillData().
+    *
+    * @pre !isFillDataInProgress()
+    */
+   void
+   beginFillData(
+      double fill_time,
+      bool do_physical_boundary_fill = true) const;
+
+   /*!
+    * @brief Complete a fill started by beginFillData().
+    *
+    * When this returns, the destination data is filled as it would have
+    * been by fillData().
+    *
+    * @pre isFillDataInProgress()
+    */
+   void
+   completeFillData() const;
+
+   /*!
+    * @brief Return whether a fill started with beginFillData() has not
+    * yet been completed.
+    */
+   bool
+   isFillDataInProgress() const
+   {
+      return d_fill_in_progress;
+   }
+
    /*!
     * @brief Return refine equivalence classes.
     *
@@ -313,6 +420,32 @@ public:
     */
    void deallocateInternalData();
 
+   /*!
+    * @brief Set the maximum number of bytes kept in the scratch data pool.
+    *
+    * A value of zero frees the pool and disables it.  Otherwise the pool
+    * is created if needed; see ScratchDataPool::setMaxBytes().  The
+    * default comes from the input parameter scratch_pool_max_mbytes.
+    *
+    * @param[in] max_bytes
+    *
+    * @pre !isFillDataInProgress()
+    */
+   void
+   setScratchPoolMaxBytes(
+      size_t max_bytes);
+
+   /*!
+    * @brief Return the scratch data pool of this schedule, which gives
+    * its hit rate and the number of bytes retained.  The pointer is null
+    * if pooling is disabled.
+    */
+   const std::shared_ptr<ScratchDataPool>&
+   getScratchDataPool() const
+   {
+      return d_top_refine_schedule->d_scratch_pool;
+   }
+
    /*!
     * @brief Print the refine schedule data to the specified data stream.
     *
@@ -328,6 +461,14 @@ private:
     */
    static const int BIG_GHOST_CELL_WIDTH = 10;
 
+   /*
+    * MPI tags of the fine-priority level schedule.  They differ from the
+    * default tags used by the coarse-priority level schedule because both
+    * schedules have messages in flight during a fill.
+    */
+   static const int RefineSchedule_FINE_PRIORITY_TAG0 = 2;
+   static const int RefineSchedule_FINE_PRIORITY_TAG1 = 3;
+
    RefineSchedule(
       const RefineSchedule&);                   // not implemented
    RefineSchedule&
@@ -495,6 +636,32 @@ private:
       const std::shared_ptr<hier::PatchLevel>& level,
       double fill_time) const;
 
+   /*!
+    * @brief Allocate components on a level, taking the data from the
+    * scratch data pool when there is one.
+    *
+    * @param[in,out] level
+    * @param[in] components
+    * @param[in] fill_time
+    */
+   void
+   allocatePooledData(
+      hier::PatchLevel& level,
+      const hier::ComponentSelector& components,
+      double fill_time) const;
+
+   /*!
+    * @brief Deallocate components on a level, returning the data to the
+    * scratch data pool when there is one.
+    *
+    * @param[in,out] level
+    * @param[in] components
+    */
+   void
+   deallocatePooledData(
+      hier::PatchLevel& level,
+      const hier::ComponentSelector& components) const;
+
    /*!
     * @brief Recursively fill the destination level with data at the
     * given time.
@@ -513,6 +680,30 @@ private:
       double fill_time,
       bool do_physical_boundary_fill) const;
 
+   /*!
+    * @brief First phase of recursiveFill().
+    *
+    * Fills the coarse interpolation levels, begins the communication of
+    * both level-to-level schedules and does their local copies.
+    *
+    * @param[in]  fill_time  Simulation time when the fill takes place
+    * @param[in]  do_physical_boundary_fill  See recursiveFill().
+    */
+   void
+   beginRecursiveFill(
+      double fill_time,
+      bool do_physical_boundary_fill) const;
+
+   /*!
+    * @brief Second phase of recursiveFill().
+    *
+    * Completes the level-to-level communication, interpolates from the
+    * coarse interpolation levels and fills the physical and singularity
+    * boundaries, in the same order as a single-phase fill.
+    */
+   void
+   completeRecursiveFill() const;
+
    /*!
     * @brief Fill the physical boundaries for each patch on d_dst_level.
     *
@@ -950,11 +1141,26 @@ private:
    void
    initializeDomainAndGhostInformation();
 
+   /*!
+    * @brief Turn off threaded transactions in the level schedules if
+    * a refine item reads data that a copy may write.
+    *
+    * Threaded schedules copy data for different destination patches
+    * concurrently, which is only safe if no copy reads data that
+    * another copy writes.  Filling the ghosts of a component from its
+    * own interiors is safe unless the data lives on patch borders or is
+    * time interpolated; reading the scratch component of another item
+    * is not.  Sets d_reads_scratch.
+    */
+   void
+   restrictThreadedTransactions();
+
    /*!
     * @brief Utility function to set up local copies of refine items.
     *
     * An array of refine data items obtained from the CoarsenClasses object
     * is stored locally here to facilitate interaction with transactions.
+    * Also sets d_fine_priority_on_border.
     *
     * @param[in] refine_classes
     */
@@ -1324,6 +1530,58 @@ private:
    hier::ComponentSelector d_coarse_encon_encon_work_vector;
    bool d_internal_allocated;
 
+   /*!
+    * @brief State of a fill between its begin and complete phases.
+    *
+    * The component selectors record what was allocated by the begin
+    * phase so the complete phase can deallocate it.
+    */
+   mutable bool d_fill_in_progress;
+   mutable double d_fill_time;
+   mutable bool d_fill_do_physical_boundary;
+   mutable hier::ComponentSelector d_fill_dst_scratch_vector;
+   mutable hier::ComponentSelector d_fill_encon_scratch_vector;
+   mutable hier::ComponentSelector d_fill_nbr_fill_scratch_vector;
+   mutable hier::ComponentSelector d_fill_nbr_fill_dst_vector;
+   mutable hier::ComponentSelector d_fill_coarse_scratch_vector;
+   mutable hier::ComponentSelector d_fill_coarse_work_vector;
+   mutable hier::ComponentSelector d_fill_coarse_encon_scratch_vector;
+   mutable hier::ComponentSelector d_fill_coarse_encon_work_vector;
+   mutable hier::ComponentSelector d_fill_coarse_nbr_fill_scratch_vector;
+   mutable hier::ComponentSelector d_fill_coarse_nbr_fill_work_vector;
+   mutable hier::ComponentSelector d_fill_nbr_blk_fill_scratch_vector;
+   mutable hier::ComponentSelector d_fill_nbr_blk_fill_work_vector;
+   mutable hier::ComponentSelector d_fill_nbr_blk_fill_dst_vector;
+   mutable hier::ComponentSelector d_fill_coarse_interp_encon_scratch_vector;
+   mutable hier::ComponentSelector d_fill_coarse_interp_encon_work_vector;
+   mutable hier::ComponentSelector d_fill_coarse_encon_encon_scratch_vector;
+   mutable hier::ComponentSelector d_fill_coarse_encon_encon_work_vector;
+
+   /*!
+    * @brief Pool of scratch data reused between fills.
+    *
+    * Only the top schedule's pool is used; it is null if pooling is
+    * disabled.
+    */
+   std::shared_ptr<ScratchDataPool> d_scratch_pool;
+
+   /*!
+    * @brief Whether a refine item reads data that a copy may write.
+    *
+    * @see restrictThreadedTransactions()
+    */
+   bool d_reads_scratch;
+
+   /*!
+    * @brief Whether a fine-priority refine item has data living on patch
+    * borders.
+    *
+    * Interpolated data may then overlap the fine-priority data on level
+    * boundaries, so local copies done before interpolation are repeated
+    * after it.  Set in setRefineItems().
+    */
+   bool d_fine_priority_on_border;
+
    /*!
     * @brief Shared debug checking flag.
     */
@@ -1334,6 +1592,11 @@ private:
     */
    static bool s_barrier_and_time;
 
+   /*!
+    * @brief Default maximum size of the scratch data pool, from input.
+    */
+   static size_t s_scratch_pool_max_bytes;
+
    /*!
     * @brief Flag indicating if any RefineSchedule has read the input database
     * for static data.
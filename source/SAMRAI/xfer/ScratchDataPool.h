@@ -0,0 +1,266 @@
+/*************************************************************************
+ *
+ * This file is part of the SAMRAI distribution.  For full copyright
+ * information, see COPYRIGHT and LICENSE.
+ *
+ * Copyright:     (c) 1997-2017 Lawrence Livermore National Security, LLC
+ * Description:   Pool of scratch patch data reused between fills
+ *
+ ************************************************************************/
+
+#ifndef included_xfer_ScratchDataPool
+#define included_xfer_ScratchDataPool
+
+#include "SAMRAI/SAMRAI_config.h"
+
+#include "SAMRAI/hier/BlockId.h"
+#include "SAMRAI/hier/ComponentSelector.h"
+#include "SAMRAI/hier/Index.h"
+#include "SAMRAI/hier/PatchData.h"
+#include "SAMRAI/hier/PatchLevel.h"
+
+#include <iostream>
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace SAMRAI {
+namespace xfer {
+
+/*!
+ * @brief Class ScratchDataPool keeps patch data released by a
+ * RefineSchedule so that later fills can reuse it instead of allocating
+ * new data.
+ *
+ * Released data is keyed by its patch data component and the box of
+ * the patch it was allocated on.  When the same component is allocated
+ * on a patch with the same box, the pooled data is placed on the patch
+ * and its time is reset.  The pool retains at most a given number of
+ * bytes, as computed by hier::PatchDataFactory::getSizeOfMemory();
+ * data released when the pool is full is freed.
+ *
+ * The pool statistics can be recorded with recordStatistics() as
+ * tbox::Statistic values, so that they are reduced and printed with the
+ * other statistics of the tbox::Statistician.  Each pool records at its
+ * own sequence number, so the statistics of different schedules are
+ * kept apart and recording again only updates the pool's entry.
+ *
+ * Reused data is not reinitialized.  Like newly allocated data, its
+ * values must be considered undefined until the fill writes them.
+ *
+ * The pool is owned by the top RefineSchedule and shared by the
+ * schedules it creates for coarser levels, so it lives until the
+ * schedule is rebuilt for a new hierarchy configuration.
+ *
+ * @see RefineSchedule
+ */
+
+class ScratchDataPool
+{
+public:
+   /*!
+    * @brief Construct an empty pool.
+    *
+    * @param[in] max_bytes  Maximum number of bytes retained by the pool.
+    */
+   explicit ScratchDataPool(
+      size_t max_bytes);
+
+   /*!
+    * @brief The destructor frees all pooled data.
+    */
+   ~ScratchDataPool();
+
+   /*!
+    * @brief Allocate the specified components on all patches of a level,
+    * reusing pooled data where possible.
+    *
+    * Components that are already allocated on a patch are left alone,
+    * except that their time is set.
+    *
+    * @param[in] level
+    * @param[in] components
+    * @param[in] time
+    */
+   void
+   allocatePatchData(
+      hier::PatchLevel& level,
+      const hier::ComponentSelector& components,
+      double time);
+
+   /*!
+    * @brief Deallocate the specified components on all patches of a
+    * level, keeping the data in the pool while it is below its maximum
+    * size.
+    *
+    * @param[in] level
+    * @param[in] components
+    */
+   void
+   deallocatePatchData(
+      hier::PatchLevel& level,
+      const hier::ComponentSelector& components);
+
+   /*!
+    * @brief Free all pooled data.
+    *
+    * Statistics are not reset.
+    */
+   void
+   clear();
+
+   /*!
+    * @brief Return the maximum number of bytes retained by the pool.
+    */
+   size_t
+   getMaxBytes() const
+   {
+      return d_max_bytes;
+   }
+
+   /*!
+    * @brief Set the maximum number of bytes retained by the pool.
+    *
+    * If the pool holds more than the new maximum, it is cleared.
+    *
+    * @param[in] max_bytes
+    */
+   void
+   setMaxBytes(
+      size_t max_bytes)
+   {
+      d_max_bytes = max_bytes;
+      if (d_bytes_retained > d_max_bytes) {
+         clear();
+      }
+   }
+
+   /*!
+    * @brief Return the number of bytes currently retained by the pool.
+    */
+   size_t
+   getBytesRetained() const
+   {
+      return d_bytes_retained;
+   }
+
+   /*!
+    * @brief Return the largest number of bytes retained by the pool
+    * at any time.
+    */
+   size_t
+   getMaxBytesRetained() const
+   {
+      return d_max_bytes_retained;
+   }
+
+   /*!
+    * @brief Return the number of allocations satisfied from the pool.
+    */
+   size_t
+   getNumberOfHits() const
+   {
+      return d_num_hits;
+   }
+
+   /*!
+    * @brief Return the number of allocations that created new data.
+    */
+   size_t
+   getNumberOfMisses() const
+   {
+      return d_num_misses;
+   }
+
+   /*!
+    * @brief Return the fraction of allocations satisfied from the pool,
+    * or zero if nothing has been allocated.
+    */
+   double
+   getHitRate() const
+   {
+      const size_t total = d_num_hits + d_num_misses;
+      return total > 0 ?
+             static_cast<double>(d_num_hits) / static_cast<double>(total) :
+             0.0;
+   }
+
+   /*!
+    * @brief Print the pool statistics to the specified stream.
+    *
+    * @param[out] stream
+    */
+   void
+   printStatistics(
+      std::ostream& stream) const;
+
+   /*!
+    * @brief Record the hit rate and the largest number of bytes retained
+    * in the processor statistics SDP_HitRate and SDP_BytesRetained of
+    * the tbox::Statistician.
+    *
+    * The values are written at the sequence number of this pool, which
+    * is the number of pools constructed before it, overwriting what the
+    * pool recorded earlier.  Schedules are created collectively, so a
+    * sequence number refers to the same schedule on all processes.
+    */
+   void
+   recordStatistics();
+
+private:
+   ScratchDataPool(
+      const ScratchDataPool&);                // not implemented
+   ScratchDataPool&
+   operator = (
+      const ScratchDataPool&);                // not implemented
+
+   /*
+    * Pool key:  patch data component and patch box.
+    */
+   struct Key {
+      Key(
+         int id,
+         const hier::Box& box);
+      int d_id;
+      hier::BlockId d_block_id;
+      hier::Index d_lower;
+      hier::Index d_upper;
+   };
+
+   struct KeyLess {
+      bool
+      operator () (
+         const Key& a,
+         const Key& b) const;
+   };
+
+   struct Entry {
+      std::shared_ptr<hier::PatchData> d_data;
+      size_t d_bytes;
+   };
+
+   typedef std::map<Key, std::vector<Entry>, KeyLess> PoolMap;
+
+   PoolMap d_pool;
+
+   size_t d_max_bytes;
+   size_t d_bytes_retained;
+   size_t d_max_bytes_retained;
+   size_t d_num_hits;
+   size_t d_num_misses;
+
+   /*
+    * Sequence number of the statistics recorded by this pool.
+    */
+   int d_statistics_seq_num;
+
+   /*
+    * Number of pools constructed, used to number their statistics.
+    */
+   static int s_num_pools;
+};
+
+}
+}
+
+#endif
@@ -142,6 +142,27 @@ public:
    int
    solvePoisson();
 
+   /*!
+    * @brief Check a smoother against a reference smoother.
+    *
+    * Starting from the exact solution as the error and the rhs as the
+    * residual, smooth each level in turn, coarsest first, with
+    * fac_ops and with reference_ops for num_sweeps sweeps, and compare
+    * the smoothed errors.  The operators must differ only in the way
+    * they smooth.
+    *
+    * @param fac_ops Operators whose smoother is checked
+    * @param reference_ops Operators with the reference smoother
+    * @param num_sweeps Number of sweeps on each level
+    *
+    * @return Number of failures
+    */
+   int
+   compareSmoothers(
+      solv::CellPoissonFACOps& fac_ops,
+      solv::CellPoissonFACOps& reference_ops,
+      int num_sweeps);
+
 #ifdef HAVE_HDF5
    /*!
     * @brief Set up external plotter to plot internal
@@ -206,6 +227,12 @@ private:
     */
    int d_comp_soln_id, d_exact_id, d_rhs_id;
 
+   /*!
+    * @brief Descriptor index of the error smoothed by the reference
+    * smoother in compareSmoothers().
+    */
+   int d_reference_error_id;
+
    //@}
 
 };
@@ -91,6 +91,8 @@ public:
    ///      initializeDataOnPatch(),
    ///      computeStableDtOnPatch(),
    ///      computeFluxesOnPatch(),
+   ///      computeInteriorFluxesOnPatch(),
+   ///      computeBoundaryFluxesOnPatch(),
    ///      conservativeDifferenceOnPatch(),
    ///      tagGradientDetectorCells(),
    ///      tagRichardsonExtrapolationCells()
@@ -164,6 +166,29 @@ public:
       const double time,
       const double dt);
 
+   /**
+    * Compute the fluxes while the ghost cells are still being filled.
+    * Patches too small to have faces away from the ghost stencil return
+    * false.  The fluxes are computed on the whole patch; only those on
+    * faces at least d_nghosts from the patch boundary are meaningful.
+    */
+   bool
+   computeInteriorFluxesOnPatch(
+      hier::Patch& patch,
+      const double time,
+      const double dt);
+
+   /**
+    * Recompute the fluxes once the ghost cells are filled and count the
+    * faces away from the patch boundary whose fluxes differ from those
+    * computed in computeInteriorFluxesOnPatch().
+    */
+   void
+   computeBoundaryFluxesOnPatch(
+      hier::Patch& patch,
+      const double time,
+      const double dt);
+
    /**
     * Update linear advection solution variables by performing a conservative
     * difference with the fluxes calculated in computeFluxesOnPatch().
@@ -375,6 +400,16 @@ public:
    printClassData(
       ostream& os) const;
 
+   /**
+    * Return the number of interior fluxes that changed between
+    * computeInteriorFluxesOnPatch() and computeBoundaryFluxesOnPatch().
+    */
+   int
+   getNumberOfInteriorFluxMismatches() const
+   {
+      return d_num_interior_flux_mismatches;
+   }
+
 private:
    /*
     * These private member functions read data from input and restart.
@@ -470,6 +505,12 @@ private:
     */
    double d_source;
    bool d_check_fluxes;
+
+   /*
+    * Number of interior fluxes found to differ between the overlapped
+    * and the final flux computation.
+    */
+   int d_num_interior_flux_mismatches;
    
    /*
     *  Parameters for numerical method: